@@ -57,105 +57,358 @@ DS_Tester::~DS_Tester() {
 
 /***************************************************************************//**
  * @brief
- *  This is the garbage collection method for the treiber stack. 
+ *  Announces the start of an operation to the chosen reclamation scheme
  *
  * @details
- *  Finds the minimum epoch in which nodes can be freed, then scans the retired nodes list to free respectively.
+ *  Epoch based and interval based reclamation reserve before every operation. Quiescent state
+ *  based reclamation has nothing to do here, which is where its read side savings come from.
  *
  * @note
- * 	Each thread cleans up their own garbage
+ *  none
  *
- * @param[in] retired_nodes
- *  List of retired nodes waiting to be freed
+ * @param[in] inArgs
+ *  Calling thread's arguments
  *
- * @param[in] reservations
- *  List of each node's current epoch
- * 
- * @param[in] number_of_threads
- *  Number of threads
- * 
- ******************************************************************************/ 
-static void extermination_treiber(multimap<int,tstack_node*> &retired_nodes, atomic<int>* reservations, int number_of_threads) {
+ ******************************************************************************/
+static inline void begin_operation(DS_Tester_args* inArgs) {
 
-    int min = INT_MAX; 
+    switch(inArgs->reclamation) {
 
-    for(int i = 0; i < number_of_threads; i++) {
+        case(epoch_based):{
+            inArgs->ebr->start_op(inArgs->tid);
+            break;
+        }
+
+        case(interval_based):{
+            inArgs->ibr->start_op(inArgs->tid);
+            break;
+        }
+
+        default:{
+            break;
+        }
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Announces the end of an operation to the chosen reclamation scheme
+ *
+ * @details
+ *  The test loops stand in for an event loop, so with quiescent state based reclamation every
+ *  QUIESCENT_INTERVAL operations the thread announces that it holds no references into the data structure.
+ *
+ * @note
+ *  Any node returned by the operation must already be retired
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] countdown
+ *  Operations left until the next quiescent state
+ *
+ ******************************************************************************/
+static inline void end_operation(DS_Tester_args* inArgs, int* countdown) {
 
-        if(min > reservations[i].load(ACQ)) {
+    switch(inArgs->reclamation) {
 
-            min = reservations[i].load(ACQ);
+        case(epoch_based):{
+            inArgs->ebr->end_op(inArgs->tid);
+            break;
+        }
 
+        case(interval_based):{
+            inArgs->ibr->end_op(inArgs->tid);
+            break;
         }
 
+        case(quiescent_state_based):{
+
+            *countdown += -1;
+
+            if(*countdown == 0) {
+
+                inArgs->qsbr->quiescent(inArgs->tid);
+                *countdown = QUIESCENT_INTERVAL;
+
+            }
+            break;
+        }
     }
-    
-    auto itr = retired_nodes.begin();
-    itr++;
 
-    for(itr; itr != retired_nodes.end(); itr++) {
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Hands a removed node to the chosen reclamation scheme
+ *
+ * @details
+ *  Once the node is safe to free it goes back to the data structure's node pool
+ *
+ * @note
+ *  none
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] node
+ *  Node removed from the data structure
+ *
+ * @param[in] pool
+ *  Pool the node was allocated from
+ *
+ ******************************************************************************/
+template<typename T>
+static inline void retire_node(DS_Tester_args* inArgs, T* node, Node_Pool<T>* pool) {
 
-        if(min > itr->first) {
+    switch(inArgs->reclamation) {
 
-            auto itcopy = itr;
-            itcopy--;
-            delete(itr->second);
-            retired_nodes.erase(itr);
-            itr = itcopy;
+        case(epoch_based):{
+            inArgs->ebr->retire(inArgs->tid, node, &Node_Pool<T>::reclaim, pool);
+            break;
+        }
 
+        case(quiescent_state_based):{
+            inArgs->qsbr->retire(inArgs->tid, node, &Node_Pool<T>::reclaim, pool);
+            break;
         }
 
+        case(interval_based):{
+            inArgs->ibr->retire(inArgs->tid, node, node->birth_era, &Node_Pool<T>::reclaim, pool);
+            break;
+        }
     }
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is the garbage collection method for the m&s queue. 
+ *  Adds completed operations to the calling thread's counter
  *
  * @details
- *  Finds the minimum epoch in which nodes can be freed, then scans the retired nodes list to free respectively.
+ *  The thread is the counter's only writer, so a plain load and store is enough and no read
+ *  modify write ever crosses cores
  *
  * @note
- * 	Each thread cleans up their own garbage
+ *  none
  *
- * @param[in] retired_nodes
- *  List of retired nodes waiting to be freed
+ * @param[in] inArgs
+ *  Calling thread's arguments
  *
- * @param[in] reservations
- *  List of each node's current epoch
- * 
- * @param[in] number_of_threads
- *  Number of threads
- * 
- ******************************************************************************/ 
-static void extermination_ms(multimap<int,ms_node*> retired_nodes, atomic<int>* reservations, int number_of_threads) {
+ * @param[in] operations
+ *  Number of operations completed
+ *
+ ******************************************************************************/
+static inline void count_operations(DS_Tester_args* inArgs, uint64_t operations) {
 
-    int min = INT_MAX; 
+    inArgs->counter->ops.store(inArgs->counter->ops.load(RELAXED) + operations, RELAXED);
 
-    for(int i = 0; i < number_of_threads; i++) {
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Reads the clock at the start of a timed operation
+ *
+ * @details
+ *  Returns 0 without reading the clock when latencies are not being recorded
+ *
+ * @note
+ *  none
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ ******************************************************************************/
+static inline uint64_t operation_clock(DS_Tester_args* inArgs) {
 
-        if(min > reservations[i].load(ACQ)) {
+    if(inArgs->histograms == NULL) {
+        return 0;
+    }
 
-            min = reservations[i].load(ACQ);
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
 
-        }
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Records the latency of an operation that started at the given clock reading
+ *
+ * @details
+ *  The value goes into the calling thread's own histogram for the kind of operation
+ *
+ * @note
+ *  Does nothing when latencies are not being recorded
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] type
+ *  Kind of operation
+ *
+ * @param[in] started
+ *  Clock reading from operation_clock
+ *
+ ******************************************************************************/
+static inline void record_latency(DS_Tester_args* inArgs, operation_type type, uint64_t started) {
+
+    if(inArgs->histograms == NULL) {
+        return;
+    }
+
+    inArgs->histograms[type].record(operation_clock(inArgs) - started);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Opens the calling thread's hardware counter group
+ *
+ * @details
+ *  Called before the start barrier, so opening the counters is not part of the timed region
+ *
+ * @note
+ *  Does nothing when counters were not requested
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ ******************************************************************************/
+static inline void open_counters(DS_Tester_args* inArgs) {
+
+    if(inArgs->perf != NULL) {
+        inArgs->perf_error = inArgs->perf->open(inArgs->hitm_raw);
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Starts the calling thread's hardware counters as the timed region begins
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  Does nothing when counters were not requested
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ ******************************************************************************/
+static inline void start_counters(DS_Tester_args* inArgs) {
+
+    if(inArgs->perf != NULL) {
+        inArgs->perf->start();
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Stops the calling thread's hardware counters as the timed region ends
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  Does nothing when counters were not requested
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ ******************************************************************************/
+static inline void stop_counters(DS_Tester_args* inArgs) {
+
+    if(inArgs->perf != NULL) {
+        inArgs->perf->stop();
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns whether the calling thread should run another iteration of the workload loop
+ *
+ * @details
+ *  Without a duration every thread runs its number of iterations. With a duration threads run
+ *  until the timer thread stops them, and the first thread to get here starts the warmup. When
+ *  a thread first sees the measured window begin it drops what it recorded during the warmup,
+ *  its latency histograms are emptied and its hardware counters restarted.
+ *
+ * @note
+ *  One relaxed check per iteration, the phase only changes twice per run
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] iteration
+ *  Iterations the thread has already run
+ *
+ ******************************************************************************/
+static inline bool keep_running(DS_Tester_args* inArgs, int iteration) {
 
+    if(inArgs->duration_ms == 0) {
+        return iteration < inArgs->iterations;
     }
 
-    for(auto itr = retired_nodes.begin(); itr != retired_nodes.end(); itr++) {
+    int phase = inArgs->phase->load(ACQ);
+
+    if(phase == starting_phase) {
+        inArgs->phase->compare_exchange_strong(phase, warmup_phase, ACQREL, ACQ);
+        phase = inArgs->phase->load(ACQ);
+    }
+
+    if(phase != inArgs->seen_phase) {
+
+        inArgs->seen_phase = phase;
 
-        if(min > itr->first) {
+        if(phase == measure_phase) {
 
-            auto itcopy = itr;
-            itcopy--;
-            delete(itr->second);
-            retired_nodes.erase(itr);
-            itr = itcopy;
+            if(inArgs->histograms != NULL) {
+                for(int type = 0; type < operation_types; type++) {
+                    inArgs->histograms[type].clear();
+                }
+            }
+
+            start_counters(inArgs);
 
         }
 
     }
 
+    return phase != stopped_phase;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Stalls the calling thread in the middle of an operation
+ *
+ * @details
+ *  Models a thread being descheduled while it holds a reservation, or while it is between two
+ *  quiescent states. Epoch based and quiescent state based reclamation cannot free anything retired
+ *  during the stall, interval based reclamation only holds back nodes allocated before it.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] countdown
+ *  Operations left until the next quiescent state
+ *
+ ******************************************************************************/
+static void stall_operation(DS_Tester_args* inArgs, int* countdown) {
+
+    begin_operation(inArgs);
+    usleep(inArgs->stall_ms * 1000);
+    end_operation(inArgs, countdown);
+
 }
 
 /***************************************************************************//**
@@ -164,122 +417,83 @@ static void extermination_ms(multimap<int,ms_node*> retired_nodes, atomic<int>*
  *
  * @details
  *  Pushes numbers from a counter for the given number of iterations. Then immediatly pops for the given
- *  number of iterations. This method uses epoch based reclamation for garbage collection. There are two counters that are used in this methhod. 
- *  One that is in charge of when garbage collection occurs and the other for when the global epoch is increased.
+ *  number of iterations. Popped nodes are retired to the chosen reclamation subsystem, which frees them once no other
+ *  thread can still be reading them. Epoch based reclamation announces every pop, quiescent state based reclamation only
+ *  announces a quiescent state every QUIESCENT_INTERVAL operations, so running both shows the read side overhead of the
+ *  reservations. When a stall is requested the last thread stalls inside an operation before starting. The sharded
+ *  stack has the same interface and is tested through this fork as well.
  *
  * @note
- * 	Each thread will execute this method individually
+ * 	Each thread will execute this method individually. Pop returning NULL is used to know when all pops have occured.
  *
  * @param[in] args
  *  
  *
  ******************************************************************************/ 
+template<typename S>
 static void* fork_Treiber(void* args){
 
 	// Extracting arguments from the passed struct
 	DS_Tester_args* inArgs = (DS_Tester_args*)args;
-	Locks* lock = inArgs->lock;
     Barriers* bar = inArgs->barrier;
-    T_stack* t_stack = inArgs->t_stack;
-    SGL_stack* s_stack = inArgs->s_stack;
-    MS_queue* m_queue = inArgs->m_queue;
-    SGL_Queue* s_queue = inArgs->s_queue;
-    atomic<int>* epoch = inArgs->epoch;
-    atomic<int>* reservations = inArgs->reservations;
+    S* t_stack = (S*)inArgs->structure;
 	int tid = inArgs->tid;
 	int number_of_threads = inArgs->number_of_threads;
     int iterations = inArgs->iterations;
 
-    thread_local multimap<int,tstack_node*> retired_nodes; 
     int value = tid;
-    int garbage_genocide_countdown = 500;
-    int time_shift_countdown = 100;
+    int countdown = QUIESCENT_INTERVAL;
 
+    open_counters(inArgs);
 	bar->wait();
+    start_counters(inArgs);
     
     // START CLOCK
     if(tid == 0) {
         clock_gettime(CLOCK_MONOTONIC,&start);
     }
+
+    if(inArgs->stall_ms > 0 && tid == number_of_threads - 1) {
+        stall_operation(inArgs, &countdown);
+    }
     
     for(int i = 0; i < iterations; i ++) {
     
-        t_stack->push(value);
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        t_stack->push(value, tid);
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, insert_operation, started);
+        count_operations(inArgs, 1);
         value += 1;
 
     }
 
     while(true){
 
-        int time = epoch[0].load(ACQ);
-        reservations[tid].store(time,ACQREL);
-
-        tstack_node* to_retire = t_stack->pop();
-
-        // Making sure the value isn't the end saginal 
-        if(to_retire->val != -1) {
-
-            bool flag = false;
-            for(auto itr = retired_nodes.begin(); itr != retired_nodes.end(); itr++) {
-                
-                if((tstack_node*)itr->second == to_retire) {
-                    flag = true;
-                    break;
-                    
-                }
-                
-            }
-            
-            if(flag == false) {
-             
-                retired_nodes.insert({time, to_retire});
-                
-            }
-            
-            
-            
-        }
-
-        garbage_genocide_countdown += -1;
-        time_shift_countdown += -1;
-        
-        // performiong garbage collection when either garbage collection countdown hits zero or if at the end of all pops
-        if(garbage_genocide_countdown == 0 || to_retire->val == -1) {
-
-            if(retired_nodes.size() > 0) {
-                
-                extermination_treiber(retired_nodes, reservations, number_of_threads);
-
-            }
-            garbage_genocide_countdown = 500;
-            
-            if(to_retire->val == -1) {
-                delete(to_retire);
-                break;
-            }
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        tstack_node* to_retire = t_stack->pop(tid);
 
-        }
-        
-        // When time shift countdown is zzero, tid 0 will increment the global epoch
-        if(tid == 0 && time_shift_countdown == 0) {
-            
-            epoch[0].store(time + 1, ACQREL);
-            time_shift_countdown = 100;
-            
+        // Stopping once the stack is empty
+        if(to_retire == NULL) {
+            end_operation(inArgs, &countdown);
+            record_latency(inArgs, remove_operation, started);
+            break;
         }
 
+        retire_node(inArgs, to_retire, t_stack->node_pool());
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, remove_operation, started);
+        count_operations(inArgs, 1);
 
     }
-    
-    
-    // Making sure all retired nodees are freed before exiting
-    while(retired_nodes.begin() != retired_nodes.end()) {
-        auto itr = retired_nodes.begin();
-        delete(itr->second);
-        retired_nodes.erase(itr);
-        
+
+    if(inArgs->reclamation == quiescent_state_based) {
+        inArgs->qsbr->offline(tid);
     }
     
+    stop_counters(inArgs);
 	bar->wait();
 
     // END CLOCK
@@ -287,6 +501,8 @@ static void* fork_Treiber(void* args){
         clock_gettime(CLOCK_MONOTONIC,&finish);
     }
 
+    return NULL;
+
 }
 
 /***************************************************************************//**
@@ -295,184 +511,182 @@ static void* fork_Treiber(void* args){
  *
  * @details
  *  Enqueues numbers from a counter for the given number of iterations. Then immediatly dequeues for the given
- *  number of iterations. This method uses epoch based reclamation for garbage collection. There are two counters that are used in this methhod. 
- *  One that is in charge of when garbage collection occurs and the other for when the global epoch is increased.
+ *  number of iterations. Dequeued nodes are retired to the chosen reclamation subsystem, which frees them once no other
+ *  thread can still be reading them. When a stall is requested the last thread stalls inside an operation before starting.
  *
  * @note
- * 	Each thread will execute this method individually. An end signal of -1 is used to know when all pops have occured. 
+ * 	Each thread will execute this method individually. Dequeue returning NULL is used to know when all dequeues have occured. 
  *
  * @param[in] args
  *  
  *
  ******************************************************************************/ 
+template<typename S>
 static void* fork_MS(void* args){
 
 	// Extracting arguments from the passed struct
 	DS_Tester_args* inArgs = (DS_Tester_args*)args;
-	Locks* lock = inArgs->lock;
     Barriers* bar = inArgs->barrier;
-    T_stack* t_stack = inArgs->t_stack;
-    SGL_stack* s_stack = inArgs->s_stack;
-    MS_queue* m_queue = inArgs->m_queue;
-    SGL_Queue* s_queue = inArgs->s_queue;
-    atomic<int>* epoch = inArgs->epoch;
-    atomic<int>* reservations = inArgs->reservations;
+    S* m_queue = (S*)inArgs->structure;
 	int tid = inArgs->tid;
 	int number_of_threads = inArgs->number_of_threads;
     int iterations = inArgs->iterations;
 
-    thread_local multimap<int,ms_node*> retired_nodes; 
     int value = tid;
-    int garbage_genocide_countdown = 500;
-    int time_shift_countdown = 100;
+    int countdown = QUIESCENT_INTERVAL;
 
+    open_counters(inArgs);
 	bar->wait();
+    start_counters(inArgs);
     
     // START CLOCK
     if(tid == 0) {
         clock_gettime(CLOCK_MONOTONIC,&start);
     }
+
+    if(inArgs->stall_ms > 0 && tid == number_of_threads - 1) {
+        stall_operation(inArgs, &countdown);
+    }
     
     for(int i = 0; i < iterations; i ++) {
     
-        m_queue->enqueue(value);
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        m_queue->enqueue(value, tid);
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, insert_operation, started);
+        count_operations(inArgs, 1);
         value += 1;
 
     }
 
     while(true){
 
-        int time = epoch[0].load(ACQ);
-        reservations[tid].store(time,ACQREL);
-
-        ms_node* to_retire = m_queue->dequeue();
-
-        // Making sure value isn't the end signal
-        if(to_retire->val != -1) {
-
-            bool flag = false;
-            for(auto itr = retired_nodes.begin(); itr != retired_nodes.end(); itr++) {
-                
-                if((ms_node*)itr->second == to_retire) {
-                    flag = true;
-                    break;
-                    
-                }
-                
-            }
-            
-            if(flag == false) {
-             
-                retired_nodes.insert({time, to_retire});
-                
-            }
-            
-            
-            
-        }
-
-        garbage_genocide_countdown += -1;
-        time_shift_countdown += -1;
-        
-        // performiong garbage collection when either garbage collection countdown hits zero or if at the end of all pops
-        if(garbage_genocide_countdown == 0 || to_retire->val == -1) {
-
-            if(retired_nodes.size() > 0) {
-                
-                extermination_ms(retired_nodes, reservations, number_of_threads);
-
-            }
-            garbage_genocide_countdown = 500;
-            
-            if(to_retire->val == -1) {
-                break;
-            }
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        ms_node* to_retire = m_queue->dequeue(tid);
 
-        }
-        
-        // When time shift countdown is zzero, tid 0 will increment the global epoch
-        if(tid == 0 && time_shift_countdown == 0) {
-            
-            epoch[0].store(time + 1, ACQREL);
-            time_shift_countdown = 100;
-            
+        // Stopping once the queue is empty
+        if(to_retire == NULL) {
+            end_operation(inArgs, &countdown);
+            record_latency(inArgs, remove_operation, started);
+            break;
         }
 
+        retire_node(inArgs, to_retire, m_queue->node_pool());
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, remove_operation, started);
+        count_operations(inArgs, 1);
 
     }
-    
 
-    // Making sure all retired nodees are freed before exiting
-    while(retired_nodes.begin() != retired_nodes.end()) {
-        auto itr = retired_nodes.begin();
-        delete(itr->second);
-        retired_nodes.erase(itr);
-        
+    if(inArgs->reclamation == quiescent_state_based) {
+        inArgs->qsbr->offline(tid);
     }
-    
 
+    stop_counters(inArgs);
 	bar->wait();
 
     // END CLOCK
     if(tid == 0) {
         clock_gettime(CLOCK_MONOTONIC,&finish);
     }
-	
+
+    return NULL;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This it the fork for the parallel testing of the Single Global Lock Stack
+ *  This it the fork for the batched testing of the Treiber Stack
  *
  * @details
- *  Pushes numbeers from a counter for the given number of iterations. Then immediatly pops for the given
- *  number of iterations.
+ *  Pushes numbers from a counter for the given number of iterations, batch values per push_bulk. Then drains the
+ *  stack with pop_all until it is empty, retiring every node in each drained chain. Whichever thread empties the stack
+ *  first does most of the draining, as a drain style consumer would.
+ *
  * @note
- * 	Each thread will execute this method individually. An end signal of -1 is used to know when all pops have occured. 
+ * 	Each thread will execute this method individually. pop_all returning NULL is used to know when all pops have occured.
  *
  * @param[in] args
  *  
  *
  ******************************************************************************/ 
-static void* fork_SGL_Stack(void* args){
+template<typename S>
+static void* fork_Treiber_bulk(void* args){
 
 	// Extracting arguments from the passed struct
 	DS_Tester_args* inArgs = (DS_Tester_args*)args;
-	Locks* lock = inArgs->lock;
     Barriers* bar = inArgs->barrier;
-    T_stack* t_stack = inArgs->t_stack;
-    SGL_stack* s_stack = inArgs->s_stack;
-    MS_queue* m_queue = inArgs->m_queue;
-    SGL_Queue* s_queue = inArgs->s_queue;
-    atomic<int>* epoch = inArgs->epoch;
-    atomic<int>* reservations = inArgs->reservations;
+    S* t_stack = (S*)inArgs->structure;
 	int tid = inArgs->tid;
-	int number_of_threads = inArgs->number_of_threads;
     int iterations = inArgs->iterations;
+    int batch = inArgs->batch;
 
-    thread_local multimap<int,ls_node*> retired_nodes; 
+    int* values = new int[batch];
     int value = tid;
-    int garbage_genocide_countdown = 500;
-    int time_shift_countdown = 100;
+    int countdown = QUIESCENT_INTERVAL;
 
+    open_counters(inArgs);
 	bar->wait();
+    start_counters(inArgs);
     
     // START CLOCK
     if(tid == 0) {
         clock_gettime(CLOCK_MONOTONIC,&start);
     }
     
-    for(int i = 0; i < iterations; i ++) {
+    for(int i = 0; i < iterations; i += batch) {
+
+        int count = iterations - i < batch ? iterations - i : batch;
+
+        for(int j = 0; j < count; j++) {
+            values[j] = value;
+            value += 1;
+        }
     
-        s_stack->push(value, lock, tid);
-        value += 1;
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        t_stack->push_bulk(values, count, tid);
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, insert_operation, started);
+        count_operations(inArgs, count);
 
     }
 
-    while(s_stack->pop(lock, tid) != -1) {}
-    
+    while(true){
+
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        tstack_node* to_retire = t_stack->pop_all(tid);
+
+        // Stopping once the stack is empty
+        if(to_retire == NULL) {
+            end_operation(inArgs, &countdown);
+            record_latency(inArgs, remove_operation, started);
+            break;
+        }
+
+        uint64_t drained = 0;
+
+        while(to_retire != NULL) {
+            tstack_node* next = to_retire->next;
+            retire_node(inArgs, to_retire, t_stack->node_pool());
+            to_retire = next;
+            drained += 1;
+        }
 
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, remove_operation, started);
+        count_operations(inArgs, drained);
+
+    }
+
+    if(inArgs->reclamation == quiescent_state_based) {
+        inArgs->qsbr->offline(tid);
+    }
+    
+    stop_counters(inArgs);
 	bar->wait();
 
     // END CLOCK
@@ -480,205 +694,1957 @@ static void* fork_SGL_Stack(void* args){
         clock_gettime(CLOCK_MONOTONIC,&finish);
     }
 
+    delete [] values;
+
+    return NULL;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This it the fork for the parallel testing of the Single Global Lock Queue
+ *  This it the fork for the batched testing of the M&S Queue
  *
  * @details
- *  Enqueues numbers from a counter for the given number of iterations. Then immediatly dequeues for the given
- *  number of iterations.
+ *  Enqueues numbers from a counter for the given number of iterations, batch values per enqueue_bulk. Then dequeues
+ *  up to batch values per dequeue_bulk until the queue is empty, retiring every dequeued node.
+ *
  * @note
- * 	Each thread will execute this method individually. An end signal of -1 is used to know when all pops have occured. 
+ * 	Each thread will execute this method individually. dequeue_bulk returning NULL is used to know when all dequeues have occured.
  *
  * @param[in] args
  *  
  *
  ******************************************************************************/ 
-static void* fork_SGL_Queue(void* args){
-	
+template<typename S>
+static void* fork_MS_bulk(void* args){
+
 	// Extracting arguments from the passed struct
 	DS_Tester_args* inArgs = (DS_Tester_args*)args;
-	Locks* lock = inArgs->lock;
     Barriers* bar = inArgs->barrier;
-    T_stack* t_stack = inArgs->t_stack;
-    SGL_stack* s_stack = inArgs->s_stack;
-    MS_queue* m_queue = inArgs->m_queue;
-    SGL_Queue* s_queue = inArgs->s_queue;
-    atomic<int>* epoch = inArgs->epoch;
-    atomic<int>* reservations = inArgs->reservations;
+    S* m_queue = (S*)inArgs->structure;
 	int tid = inArgs->tid;
-	int number_of_threads = inArgs->number_of_threads;
     int iterations = inArgs->iterations;
+    int batch = inArgs->batch;
 
-    thread_local multimap<int,ls_node*> retired_nodes; 
+    int* values = new int[batch];
     int value = tid;
-    int garbage_genocide_countdown = 500;
-    int time_shift_countdown = 100;
+    int countdown = QUIESCENT_INTERVAL;
 
+    open_counters(inArgs);
 	bar->wait();
+    start_counters(inArgs);
     
     // START CLOCK
     if(tid == 0) {
         clock_gettime(CLOCK_MONOTONIC,&start);
     }
     
-    for(int i = 0; i < iterations; i ++) {
-    
-        s_queue->enqueue(value, lock, tid);
-        value += 1;
+    for(int i = 0; i < iterations; i += batch) {
 
-    }
+        int count = iterations - i < batch ? iterations - i : batch;
 
-    while(s_queue->dequeue(lock, tid) != -1) {}
+        for(int j = 0; j < count; j++) {
+            values[j] = value;
+            value += 1;
+        }
     
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        m_queue->enqueue_bulk(values, count, tid);
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, insert_operation, started);
+        count_operations(inArgs, count);
 
-	bar->wait();
-
-    // END CLOCK
-    if(tid == 0) {
-        clock_gettime(CLOCK_MONOTONIC,&finish);
     }
 
-}
+    while(true){
+
+        int dequeued;
+
+        uint64_t started = operation_clock(inArgs);
+        begin_operation(inArgs);
+        ms_node* to_retire = m_queue->dequeue_bulk(batch, &dequeued, tid);
+
+        // Stopping once the queue is empty
+        if(to_retire == NULL) {
+            end_operation(inArgs, &countdown);
+            record_latency(inArgs, remove_operation, started);
+            break;
+        }
+
+        for(int j = 0; j < dequeued; j++) {
+            ms_node* next = to_retire->next.load(ACQ);
+            retire_node(inArgs, to_retire, m_queue->node_pool());
+            to_retire = next;
+        }
+
+        end_operation(inArgs, &countdown);
+        record_latency(inArgs, remove_operation, started);
+        count_operations(inArgs, dequeued);
+
+    }
+
+    if(inArgs->reclamation == quiescent_state_based) {
+        inArgs->qsbr->offline(tid);
+    }
+
+    stop_counters(inArgs);
+	bar->wait();
+
+    // END CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&finish);
+    }
+
+    delete [] values;
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This it the fork for the parallel testing of the tagged Treiber Stack
+ *
+ * @details
+ *  Pushes numbers from a counter for the given number of iterations. Then immediatly pops for the given
+ *  number of iterations. Popped nodes go straight back to the stack's free list, so every push after the
+ *  first few reuses a node another thread just popped.
+ *
+ * @note
+ * 	Each thread will execute this method individually. An end signal of -1 is used to know when all pops have occured. 
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+template<typename S>
+static void* fork_Tagged(void* args){
+
+	// Extracting arguments from the passed struct
+	DS_Tester_args* inArgs = (DS_Tester_args*)args;
+    Barriers* bar = inArgs->barrier;
+    S* tagged_stack = (S*)inArgs->structure;
+	int tid = inArgs->tid;
+    int iterations = inArgs->iterations;
+
+    int value = tid;
+
+    open_counters(inArgs);
+	bar->wait();
+    start_counters(inArgs);
+    
+    // START CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&start);
+    }
+    
+    for(int i = 0; i < iterations; i ++) {
+    
+        uint64_t started = operation_clock(inArgs);
+        tagged_stack->push(value);
+        record_latency(inArgs, insert_operation, started);
+        count_operations(inArgs, 1);
+        value += 1;
+
+    }
+
+    while(true) {
+
+        uint64_t started = operation_clock(inArgs);
+        int popped = tagged_stack->pop();
+        record_latency(inArgs, remove_operation, started);
+
+        // Stopping once the stack is empty
+        if(popped == -1) {
+            break;
+        }
+
+        count_operations(inArgs, 1);
+
+    }
+
+    stop_counters(inArgs);
+	bar->wait();
+
+    // END CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&finish);
+    }
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This it the fork for the parallel testing of the Single Global Lock Stack
+ *
+ * @details
+ *  Pushes numbeers from a counter for the given number of iterations. Then immediatly pops for the given
+ *  number of iterations.
+ * @note
+ * 	Each thread will execute this method individually. An end signal of -1 is used to know when all pops have occured. 
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+template<typename S>
+static void* fork_SGL_Stack(void* args){
+
+	// Extracting arguments from the passed struct
+	DS_Tester_args* inArgs = (DS_Tester_args*)args;
+	Locks* lock = inArgs->lock;
+    Barriers* bar = inArgs->barrier;
+    S* s_stack = (S*)inArgs->structure;
+	int tid = inArgs->tid;
+    int iterations = inArgs->iterations;
+
+    int value = tid;
+
+    open_counters(inArgs);
+	bar->wait();
+    start_counters(inArgs);
+    
+    // START CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&start);
+    }
+    
+    for(int i = 0; i < iterations; i ++) {
+    
+        uint64_t started = operation_clock(inArgs);
+        s_stack->push(value, lock, tid);
+        record_latency(inArgs, insert_operation, started);
+        count_operations(inArgs, 1);
+        value += 1;
+
+    }
+
+    while(true) {
+
+        uint64_t started = operation_clock(inArgs);
+        int popped = s_stack->pop(lock, tid);
+        record_latency(inArgs, remove_operation, started);
+
+        // Stopping once the stack is empty
+        if(popped == -1) {
+            break;
+        }
+
+        count_operations(inArgs, 1);
+
+    }
+    
+
+    stop_counters(inArgs);
+	bar->wait();
+
+    // END CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&finish);
+    }
+
+    return NULL;
+
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This it the fork for the parallel testing of the Single Global Lock Queue
+ *
+ * @details
+ *  Enqueues numbers from a counter for the given number of iterations. Then immediatly dequeues for the given
+ *  number of iterations.
+ * @note
+ * 	Each thread will execute this method individually. An end signal of -1 is used to know when all pops have occured. 
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+template<typename S>
+static void* fork_SGL_Queue(void* args){
+	
+	// Extracting arguments from the passed struct
+	DS_Tester_args* inArgs = (DS_Tester_args*)args;
+	Locks* lock = inArgs->lock;
+    Barriers* bar = inArgs->barrier;
+    S* s_queue = (S*)inArgs->structure;
+	int tid = inArgs->tid;
+    int iterations = inArgs->iterations;
+
+    int value = tid;
+
+    open_counters(inArgs);
+	bar->wait();
+    start_counters(inArgs);
+    
+    // START CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&start);
+    }
+    
+    for(int i = 0; i < iterations; i ++) {
+    
+        uint64_t started = operation_clock(inArgs);
+        s_queue->enqueue(value, lock, tid);
+        record_latency(inArgs, insert_operation, started);
+        count_operations(inArgs, 1);
+        value += 1;
+
+    }
+
+    while(true) {
+
+        uint64_t started = operation_clock(inArgs);
+        int dequeued = s_queue->dequeue(lock, tid);
+        record_latency(inArgs, remove_operation, started);
+
+        // Stopping once the queue is empty
+        if(dequeued == -1) {
+            break;
+        }
+
+        count_operations(inArgs, 1);
+
+    }
+    
+
+    stop_counters(inArgs);
+	bar->wait();
+
+    // END CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&finish);
+    }
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Inserts one value into any of the data structures
+ *
+ * @details
+ *  Lock free structures announce the operation to the reclamation scheme, lock based ones take
+ *  the shared lock inside the operation
+ *
+ * @note
+ *  none
+ *
+ * @param[in] structure
+ *  Structure the value is inserted into
+ *
+ * @param[in] val
+ *  Value to insert
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] countdown
+ *  Operations left until the next quiescent state
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+static inline void insert_value(T_stack<V>* structure, int val, DS_Tester_args* inArgs, int* countdown) {
+
+    begin_operation(inArgs);
+    structure->push(val, inArgs->tid);
+    end_operation(inArgs, countdown);
+
+}
+
+static inline void insert_value(Sharded_stack* structure, int val, DS_Tester_args* inArgs, int* countdown) {
+
+    begin_operation(inArgs);
+    structure->push(val, inArgs->tid);
+    end_operation(inArgs, countdown);
+
+}
+
+template<optimization_variant V>
+static inline void insert_value(MS_queue<V>* structure, int val, DS_Tester_args* inArgs, int* countdown) {
+
+    begin_operation(inArgs);
+    structure->enqueue(val, inArgs->tid);
+    end_operation(inArgs, countdown);
+
+}
+
+static inline void insert_value(Tagged_T_stack* structure, int val, DS_Tester_args*, int*) {
+
+    structure->push(val);
+
+}
+
+template<optimization_variant V>
+static inline void insert_value(SGL_stack<V>* structure, int val, DS_Tester_args* inArgs, int*) {
+
+    structure->push(val, inArgs->lock, inArgs->tid);
+
+}
+
+template<optimization_variant V>
+static inline void insert_value(SGL_Queue<V>* structure, int val, DS_Tester_args* inArgs, int*) {
+
+    structure->enqueue(val, inArgs->lock, inArgs->tid);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Finishes a lock free remove
+ *
+ * @details
+ *  Retires the removed node, if there is one, then ends the operation
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+template<typename S, typename T>
+static inline bool retire_removed(S* structure, T* node, DS_Tester_args* inArgs, int* countdown) {
+
+    if(node != NULL) {
+        retire_node(inArgs, node, structure->node_pool());
+    }
+
+    end_operation(inArgs, countdown);
+
+    return node != NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Removes one value from any of the data structures
+ *
+ * @details
+ *  Nodes removed from the lock free structures are retired to the reclamation scheme
+ *
+ * @note
+ *  Returns false when the structure was empty
+ *
+ * @param[in] structure
+ *  Structure a value is removed from
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] countdown
+ *  Operations left until the next quiescent state
+ *
+ * @param[out] value
+ *  Removed value, only valid when the remove returns true
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+static inline bool remove_value(T_stack<V>* structure, DS_Tester_args* inArgs, int* countdown, int* value) {
+
+    begin_operation(inArgs);
+    tstack_node* node = structure->pop(inArgs->tid);
+
+    if(node != NULL) {
+        *value = node->val;
+    }
+
+    return retire_removed(structure, node, inArgs, countdown);
+
+}
+
+static inline bool remove_value(Sharded_stack* structure, DS_Tester_args* inArgs, int* countdown, int* value) {
+
+    begin_operation(inArgs);
+    tstack_node* node = structure->pop(inArgs->tid);
+
+    if(node != NULL) {
+        *value = node->val;
+    }
+
+    return retire_removed(structure, node, inArgs, countdown);
+
+}
+
+template<optimization_variant V>
+static inline bool remove_value(MS_queue<V>* structure, DS_Tester_args* inArgs, int* countdown, int* value) {
+
+    begin_operation(inArgs);
+
+    return retire_removed(structure, structure->dequeue(inArgs->tid, value), inArgs, countdown);
+
+}
+
+static inline bool remove_value(Tagged_T_stack* structure, DS_Tester_args*, int*, int* value) {
+
+    *value = structure->pop();
+
+    return *value != -1;
+
+}
+
+template<optimization_variant V>
+static inline bool remove_value(SGL_stack<V>* structure, DS_Tester_args* inArgs, int*, int* value) {
+
+    *value = structure->pop(inArgs->lock, inArgs->tid);
+
+    return *value != -1;
+
+}
+
+template<optimization_variant V>
+static inline bool remove_value(SGL_Queue<V>* structure, DS_Tester_args* inArgs, int*, int* value) {
+
+    *value = structure->dequeue(inArgs->lock, inArgs->tid);
+
+    return *value != -1;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Seeds a thread's workload random number generator
+ *
+ * @details
+ *  Splitmix64 of the thread id, so every run of the same workload makes the same choices
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static inline uint64_t workload_seed(int tid) {
+
+    uint64_t z = (uint64_t)(tid + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Steps a thread's workload random number generator
+ *
+ * @details
+ *  xorshift64*, private to the thread so picking an operation never touches shared memory
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static inline uint64_t workload_random(uint64_t* state) {
+
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+
+    return x * 0x2545F4914F6CDD1DULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the fork for the mixed and pair workloads on any of the data structures
+ *
+ * @details
+ *  Before the clock starts the threads split the prefill between them, so removes do not start on
+ *  an empty structure. Then each thread performs the given number of iterations. In the mixed
+ *  workload every iteration is an insert with probability push_percent and a remove otherwise,
+ *  drawn from the thread's own generator, so inserts and removes from all threads interleave the
+ *  whole run. In the pair workload every iteration is an insert immediately followed by a remove.
+ *  When a stall is requested the last thread stalls inside an operation before starting.
+ *
+ * @note
+ * 	Each thread will execute this method individually. A remove that finds the structure empty still
+ *  counts as an iteration.
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+template<typename S>
+static void* fork_mixed(void* args){
+
+	// Extracting arguments from the passed struct
+	DS_Tester_args* inArgs = (DS_Tester_args*)args;
+    Barriers* bar = inArgs->barrier;
+    S* structure = (S*)inArgs->structure;
+	int tid = inArgs->tid;
+	int number_of_threads = inArgs->number_of_threads;
+    int push_percent = inArgs->push_percent;
+
+    int value = tid;
+    int removed;
+    int countdown = QUIESCENT_INTERVAL;
+    uint64_t rng = workload_seed(tid);
+
+    int prefill = inArgs->prefill / number_of_threads + (tid < inArgs->prefill % number_of_threads ? 1 : 0);
+
+    for(int i = 0; i < prefill; i++) {
+        insert_value(structure, value, inArgs, &countdown);
+        value += 1;
+    }
+
+    open_counters(inArgs);
+	bar->wait();
+    start_counters(inArgs);
+    
+    // START CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&start);
+    }
+
+    if(inArgs->stall_ms > 0 && tid == number_of_threads - 1) {
+        stall_operation(inArgs, &countdown);
+    }
+
+    for(int i = 0; keep_running(inArgs, i); i++) {
+
+        uint64_t started = operation_clock(inArgs);
+
+        if(inArgs->workload == pair_workload) {
+            insert_value(structure, value, inArgs, &countdown);
+            record_latency(inArgs, insert_operation, started);
+            value += 1;
+            started = operation_clock(inArgs);
+            remove_value(structure, inArgs, &countdown, &removed);
+            record_latency(inArgs, remove_operation, started);
+            count_operations(inArgs, 2);
+        }
+        else if((int)(workload_random(&rng) % 100) < push_percent) {
+            insert_value(structure, value, inArgs, &countdown);
+            record_latency(inArgs, insert_operation, started);
+            value += 1;
+            count_operations(inArgs, 1);
+        }
+        else {
+            remove_value(structure, inArgs, &countdown, &removed);
+            record_latency(inArgs, remove_operation, started);
+            count_operations(inArgs, 1);
+        }
+
+    }
+
+    if(inArgs->reclamation == quiescent_state_based) {
+        inArgs->qsbr->offline(tid);
+    }
+
+    stop_counters(inArgs);
+	bar->wait();
+
+    // END CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&finish);
+    }
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the current time as a latency stamp
+ *
+ * @details
+ *  Monotonic time in 16 ns ticks, cut down to 31 bits so the stamp fits in a value
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static inline int latency_stamp() {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t ns = (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+
+    return (int)((ns >> STAMP_SHIFT) & STAMP_MASK);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the nanoseconds since a latency stamp was taken
+ *
+ * @details
+ *  The subtraction wraps the same way the stamps do
+ *
+ * @note
+ *  none
+ *
+ * @param[in] stamp
+ *  Stamp carried by a removed value
+ *
+ ******************************************************************************/
+static inline uint64_t stamp_latency_ns(int stamp) {
+
+    uint32_t ticks = ((uint32_t)latency_stamp() - (uint32_t)stamp) & STAMP_MASK;
+
+    return (uint64_t)ticks << STAMP_SHIFT;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the fork for the producer/consumer mode on any of the data structures
+ *
+ * @details
+ *  The first producers threads each insert the given number of values, every value being the time it was inserted.
+ *  The remaining threads consume until the producers are done and the structure is empty, and measure each value's end
+ *  to end latency as the time between its insert and its removal. Consumers keep their latency totals to themselves
+ *  and leave them in their arguments for the tester to add up.
+ *
+ * @note
+ * 	Each thread will execute this method individually. A consumer reads the producer count before it removes, so an
+ *  empty remove after every producer finished means nothing is left.
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+template<typename S>
+static void* fork_role(void* args){
+
+	// Extracting arguments from the passed struct
+	DS_Tester_args* inArgs = (DS_Tester_args*)args;
+    Barriers* bar = inArgs->barrier;
+    S* structure = (S*)inArgs->structure;
+	int tid = inArgs->tid;
+	int number_of_threads = inArgs->number_of_threads;
+    int producers = inArgs->producers;
+
+    int stamp;
+    int countdown = QUIESCENT_INTERVAL;
+    int measured_phase = inArgs->seen_phase;
+    uint64_t consumed = 0;
+    uint64_t latency_sum = 0;
+    uint64_t latency_max = 0;
+
+    open_counters(inArgs);
+	bar->wait();
+    start_counters(inArgs);
+    
+    // START CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&start);
+    }
+
+    if(inArgs->stall_ms > 0 && tid == number_of_threads - 1) {
+        stall_operation(inArgs, &countdown);
+    }
+
+    if(tid < producers) {
+
+        for(int i = 0; keep_running(inArgs, i); i++) {
+            uint64_t started = operation_clock(inArgs);
+            insert_value(structure, latency_stamp(), inArgs, &countdown);
+            record_latency(inArgs, insert_operation, started);
+            count_operations(inArgs, 1);
+        }
+
+        inArgs->producers_done->fetch_add(1, ACQREL);
+
+    }
+
+    else {
+
+        for(int i = 0; inArgs->duration_ms == 0 || keep_running(inArgs, i); i++) {
+
+            // End to end latencies from the warmup are dropped
+            if(inArgs->seen_phase != measured_phase) {
+                measured_phase = inArgs->seen_phase;
+                consumed = 0;
+                latency_sum = 0;
+                latency_max = 0;
+            }
+
+            bool done = inArgs->producers_done->load(ACQ) == producers;
+
+            uint64_t started = operation_clock(inArgs);
+            bool removed = remove_value(structure, inArgs, &countdown, &stamp);
+            record_latency(inArgs, remove_operation, started);
+
+            if(removed) {
+                uint64_t latency = stamp_latency_ns(stamp);
+                consumed += 1;
+                latency_sum += latency;
+                latency_max = latency > latency_max ? latency : latency_max;
+                count_operations(inArgs, 1);
+            }
+            else if(done) {
+                break;
+            }
+
+        }
+
+    }
+
+    if(inArgs->reclamation == quiescent_state_based) {
+        inArgs->qsbr->offline(tid);
+    }
+
+    stop_counters(inArgs);
+	bar->wait();
+
+    // END CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&finish);
+    }
+
+    inArgs->consumed = consumed;
+    inArgs->latency_sum = latency_sum;
+    inArgs->latency_max = latency_max;
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Reads the clock for a validation history
+ *
+ * @details
+ *  Monotonic time in nanoseconds, comparable between threads
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static inline uint64_t history_clock() {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Adds a completed operation to the calling thread's history
+ *
+ * @details
+ *  The response time is read here, after the operation returned
+ *
+ * @note
+ *  none
+ *
+ * @param[in] inArgs
+ *  Calling thread's arguments
+ *
+ * @param[in] insert
+ *  Whether the operation was an insert
+ *
+ * @param[in] value
+ *  Value inserted or removed, -1 for a remove that found the structure empty
+ *
+ * @param[in] invoked
+ *  Clock reading from before the operation was called
+ *
+ ******************************************************************************/
+static inline void record_event(DS_Tester_args* inArgs, bool insert, int value, uint64_t invoked) {
+
+    history_event event;
+    event.insert = insert;
+    event.value = value;
+    event.invoked = invoked;
+    event.responded = history_clock();
+
+    inArgs->history->push_back(event);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the fork for the validation mode on any of the data structures
+ *
+ * @details
+ *  Runs the configured workload while every thread records each operation it completes, with the
+ *  clock read before the call and after it returns. Inserted values are unique, thread tid inserts
+ *  tid, tid + threads, tid + 2 * threads and so on, and removed values are kept instead of being
+ *  discarded. The phased workload inserts then removes until empty as the phased forks do. The
+ *  mixed and pair workloads run their loop, wait for every thread and then remove until empty, so
+ *  the history ends with an empty structure and every inserted value accounted for.
+ *
+ * @note
+ * 	Each thread will execute this method individually. Recording costs a clock read and an append
+ *  per operation, so the throughput of a validation run is not comparable to a benchmark run.
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+template<typename S>
+static void* fork_validate(void* args){
+
+	// Extracting arguments from the passed struct
+	DS_Tester_args* inArgs = (DS_Tester_args*)args;
+    Barriers* bar = inArgs->barrier;
+    S* structure = (S*)inArgs->structure;
+	int tid = inArgs->tid;
+	int number_of_threads = inArgs->number_of_threads;
+    int push_percent = inArgs->push_percent;
+
+    int value = tid;
+    int removed;
+    int countdown = QUIESCENT_INTERVAL;
+    uint64_t rng = workload_seed(tid);
+
+    int prefill = inArgs->prefill / number_of_threads + (tid < inArgs->prefill % number_of_threads ? 1 : 0);
+
+    inArgs->history->reserve(prefill + 2 * (size_t)inArgs->iterations + 1);
+
+    for(int i = 0; i < prefill; i++) {
+        uint64_t invoked = history_clock();
+        insert_value(structure, value, inArgs, &countdown);
+        record_event(inArgs, true, value, invoked);
+        value += number_of_threads;
+    }
+
+    open_counters(inArgs);
+	bar->wait();
+    start_counters(inArgs);
+    
+    // START CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&start);
+    }
+
+    if(inArgs->stall_ms > 0 && tid == number_of_threads - 1) {
+        stall_operation(inArgs, &countdown);
+    }
+
+    for(int i = 0; keep_running(inArgs, i); i++) {
+
+        bool insert = inArgs->workload == phased_workload || inArgs->workload == pair_workload ||
+            (int)(workload_random(&rng) % 100) < push_percent;
+
+        if(insert) {
+            uint64_t invoked = history_clock();
+            insert_value(structure, value, inArgs, &countdown);
+            record_event(inArgs, true, value, invoked);
+            value += number_of_threads;
+            count_operations(inArgs, 1);
+        }
+
+        if(!insert || inArgs->workload == pair_workload) {
+            uint64_t invoked = history_clock();
+            bool found = remove_value(structure, inArgs, &countdown, &removed);
+            record_event(inArgs, false, found ? removed : -1, invoked);
+            count_operations(inArgs, 1);
+        }
+
+    }
+
+    // Nothing is inserted once the drain starts, so an empty remove means the structure is empty
+    if(inArgs->workload != phased_workload) {
+        bar->wait();
+    }
+
+    while(true) {
+
+        uint64_t invoked = history_clock();
+        bool found = remove_value(structure, inArgs, &countdown, &removed);
+        record_event(inArgs, false, found ? removed : -1, invoked);
+
+        if(!found) {
+            break;
+        }
+
+        count_operations(inArgs, 1);
+
+    }
+
+    if(inArgs->reclamation == quiescent_state_based) {
+        inArgs->qsbr->offline(tid);
+    }
+
+    stop_counters(inArgs);
+	bar->wait();
+
+    // END CLOCK
+    if(tid == 0) {
+        clock_gettime(CLOCK_MONOTONIC,&finish);
+    }
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the body of the monitor thread that samples throughput while a test runs
+ *
+ * @details
+ *  Every interval the monitor reads each thread's operation counter and records how many operations
+ *  completed since the last sample, along with the smallest and largest share of any one thread. The
+ *  sample keeps the interval's measured length, so a late wakeup does not skew its rate. Samples are
+ *  only printed once the test is over, so the monitor does no output while the threads run.
+ *
+ * @note
+ * 	The monitor stops at its first wakeup after the stop flag is set, the partial interval is dropped
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+static void* monitor_throughput(void* args) {
+
+    monitor_args* inArgs = (monitor_args*)args;
+    int number_of_threads = inArgs->number_of_threads;
+
+    uint64_t* previous = new uint64_t[number_of_threads]();
+    struct timespec last, now;
+    struct timespec interval;
+    interval.tv_sec = inArgs->interval_ms / 1000;
+    interval.tv_nsec = (inArgs->interval_ms % 1000) * 1000000L;
+
+    clock_gettime(CLOCK_MONOTONIC, &last);
+
+    while(true) {
+
+        nanosleep(&interval, NULL);
+
+        if(inArgs->stop->load(ACQ)) {
+            break;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        throughput_sample sample;
+        sample.elapsed_ns = (now.tv_sec - last.tv_sec) * 1000000000ULL + (now.tv_nsec - last.tv_nsec);
+        sample.ops = 0;
+        sample.min_thread_ops = UINT64_MAX;
+        sample.max_thread_ops = 0;
+
+        for(int i = 0; i < number_of_threads; i++) {
+
+            uint64_t current = inArgs->counters[i].ops.load(RELAXED);
+            uint64_t ops = current - previous[i];
+            previous[i] = current;
+
+            sample.ops += ops;
+            sample.min_thread_ops = ops < sample.min_thread_ops ? ops : sample.min_thread_ops;
+            sample.max_thread_ops = ops > sample.max_thread_ops ? ops : sample.max_thread_ops;
+
+        }
+
+        inArgs->samples->push_back(sample);
+        last = now;
+
+    }
+
+    delete [] previous;
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the body of the timer thread that drives a duration run
+ *
+ * @details
+ *  Waits for the first test thread to start the warmup, lets the warmup run, then measures for
+ *  the duration and stops the threads. The operation counters are read as the measured window
+ *  opens and as it closes, so only operations completed inside the window are counted, and the
+ *  window's length is its own clock readings rather than the time the threads took to stop.
+ *
+ * @note
+ * 	none
+ *
+ * @param[in] args
+ *  
+ *
+ ******************************************************************************/ 
+static void* run_timer(void* args) {
+
+    timer_args* inArgs = (timer_args*)args;
+    int number_of_threads = inArgs->number_of_threads;
+
+    uint64_t* warmup_ops = new uint64_t[number_of_threads];
+    struct timespec poll, warmup, duration;
+    poll.tv_sec = 0;
+    poll.tv_nsec = 100000;
+    warmup.tv_sec = inArgs->warmup_ms / 1000;
+    warmup.tv_nsec = (inArgs->warmup_ms % 1000) * 1000000L;
+    duration.tv_sec = inArgs->duration_ms / 1000;
+    duration.tv_nsec = (inArgs->duration_ms % 1000) * 1000000L;
+
+    // The test threads may still be prefilling
+    while(inArgs->phase->load(ACQ) == starting_phase) {
+        nanosleep(&poll, NULL);
+    }
+
+    nanosleep(&warmup, NULL);
+
+    for(int i = 0; i < number_of_threads; i++) {
+        warmup_ops[i] = inArgs->counters[i].ops.load(RELAXED);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &inArgs->measure_start);
+    inArgs->phase->store(measure_phase, RELEASE);
+
+    nanosleep(&duration, NULL);
+
+    for(int i = 0; i < number_of_threads; i++) {
+        inArgs->measured_ops[i] = inArgs->counters[i].ops.load(RELAXED) - warmup_ops[i];
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &inArgs->measure_end);
+    inArgs->phase->store(stopped_phase, RELEASE);
+
+    delete [] warmup_ops;
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the name of an operation on the given data structure
+ *
+ * @details
+ *  Queues enqueue and dequeue, stacks push and pop
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static const char* operation_name(string data_structure, operation_type type) {
+
+    bool queue = data_structure.compare("msQ") == 0 || data_structure.compare("sglQ") == 0;
+
+    if(type == insert_operation) {
+        return queue ? "Enqueue" : "Push";
+    }
+
+    return queue ? "Dequeue" : "Pop";
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the order the given data structure removes values in
+ *
+ * @details
+ *  The sharded stack only keeps values in order within a shard, so its history can only be
+ *  checked for conservation
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static removal_order structure_order(string data_structure) {
+
+    if(data_structure.compare("msQ") == 0 || data_structure.compare("sglQ") == 0) {
+        return fifo_order;
+    }
+    else if(data_structure.compare("sharded") == 0) {
+        return unordered;
+    }
+
+    return lifo_order;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Prints what the validation checks found
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static void report_validation(validation_report validation, removal_order order) {
+
+    printf("Values inserted: %llu\n", (unsigned long long)validation.inserts);
+    printf("Values removed: %llu (%llu empty removes)\n", (unsigned long long)validation.removes,
+        (unsigned long long)validation.empty_removes);
+    printf("Lost values: %llu\n", (unsigned long long)validation.lost);
+    printf("Duplicated values: %llu\n", (unsigned long long)validation.duplicated);
+    printf("Unknown values: %llu\n", (unsigned long long)validation.unknown);
+
+    if(order == fifo_order) {
+        printf("FIFO violations: %llu\n", (unsigned long long)validation.fifo_violations);
+    }
+
+    switch(validation.linearizability) {
+
+        case(linearizable_history):{
+            printf("Linearizable: yes\n");
+            break;
+        }
+
+        case(non_linearizable_history):{
+            printf("Linearizable: no\n");
+            break;
+        }
+
+        case(history_too_long):{
+            printf("Linearizable: not checked (history over %d operations)\n", LINEARIZABILITY_MAX_EVENTS);
+            break;
+        }
+
+        case(search_gave_up):{
+            printf("Linearizable: not checked (search gave up after %d states)\n", LINEARIZABILITY_MAX_STATES);
+            break;
+        }
+
+        case(not_checked):{
+            printf("Linearizable: not checked (values are unordered)\n");
+            break;
+        }
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Points a lock free structure at the interval based reclaimer
+ *
+ * @details
+ *  Interval based reclamation stamps every node with its birth era, so the Treiber stack, the
+ *  sharded stack and the M&S queue need the reclaimer before their first allocation. Other
+ *  structures ignore it.
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+template<typename S>
+static void attach_ibr(S*, IBR*) {
+
+}
+
+template<optimization_variant V>
+static void attach_ibr(T_stack<V>* structure, IBR* ibr) {
+
+    structure->set_ibr(ibr);
+
+}
+
+template<optimization_variant V>
+static void attach_ibr(MS_queue<V>* structure, IBR* ibr) {
+
+    structure->set_ibr(ibr);
+
+}
+
+static void attach_ibr(Sharded_stack* structure, IBR* ibr) {
+
+    structure->set_ibr(ibr);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Prints the structure's own statistics
+ *
+ * @details
+ *  Elimination variants report how often the elimination array paired operations and the sharded
+ *  stack reports how often pops had to steal. Other structures have nothing to report.
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+template<typename S>
+static void report_statistics(S*) {
+
+}
+
+static void report_statistics(Elimination_Array* elimination) {
+
+    unsigned long long hits = elimination->hits();
+    unsigned long long attempts = elimination->attempts();
+
+    printf("Elimination hit rate: %.2f%% (%llu of %llu attempts)\n", attempts > 0 ? 100.0 * hits / attempts : 0.0, hits, attempts);
+
+}
+
+static void report_statistics(T_stack<elimination_variant>* structure) {
+
+    report_statistics(structure->elimination_array());
+
+}
+
+static void report_statistics(SGL_stack<elimination_variant>* structure) {
+
+    report_statistics(structure->elimination_array());
+
+}
+
+static void report_statistics(MS_queue<elimination_variant>* structure) {
+
+    report_statistics(structure->elimination_array());
+
+}
+
+static void report_statistics(Sharded_stack* structure) {
+
+    unsigned long long steals = structure->steals();
+    unsigned long long pops = structure->pops();
+
+    printf("Steal rate: %.2f%% (%llu of %llu pops)\n", pops > 0 ? 100.0 * steals / pops : 0.0, steals, pops);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Runs the test threads against one data structure
+ *
+ * @details
+ *  The reclaimers are created here, after the caller created the structure, so they are destroyed
+ *  first and hand their last retired nodes back to a node pool that still exists. The mixed and
+ *  pair workloads replace the structure's phased fork with the workload engine, and the producer
+ *  consumer mode replaces it with the role split fork. Every thread counts its operations in its
+ *  own padded counter. With a sampling interval a monitor thread reads the counters while the
+ *  test runs and ops/sec is printed for every interval, the total is always printed. When latencies
+ *  are recorded every thread gets a histogram per kind of operation up front, and they are merged
+ *  into one percentile report per kind once the threads are joined. With a placement policy every
+ *  thread is pinned to its CPU before the start barrier, worker threads from the moment they are
+ *  created, and the calling thread gets its own affinity back once the test is over. Hardware
+ *  counters are opened per thread, count only between the two barriers and are summed over the
+ *  threads. If the counters can not be opened the run goes on and reports them unavailable.
+ *  Returns the elapsed time and operation count, a quiet run returns them without printing. A
+ *  duration run is stopped by a timer thread instead of running out of iterations, and its
+ *  elapsed time and operation count only cover the measured window after the warmup. Validation
+ *  replaces the fork with one that records every thread's history, and the histories are checked
+ *  once the threads are joined, the result saying whether the checks passed.
+ *
+ * @note
+ * 	Thread 0 is the calling thread
+ *
+ * @param[in] structure
+ *  The data structure that will be tested
+ *
+ * @param[in] fork
+ *  Phased thread body for the data structure
+ *
+ * @param[in] config
+ *  Test settings
+ *
+ ******************************************************************************/
+template<typename S>
+static DS_Tester_result run_test(pthread_t* threads, S* structure, void* (*fork)(void*), DS_Tester_config config) {
+
+    Locks lock(config.lock);
+	Barriers barrier(config.barrier, config.number_of_threads);    
+    EBR ebr(config.number_of_threads);
+    QSBR qsbr(config.number_of_threads);
+    IBR ibr(config.number_of_threads);
+    reclamation_type reclamation_scheme = epoch_based;
+    int number_of_threads = config.number_of_threads;
+
+    if(config.reclamation.compare("qsbr") == 0) {
+        reclamation_scheme = quiescent_state_based;
+    }
+    else if(config.reclamation.compare("ibr") == 0) {
+        reclamation_scheme = interval_based;
+        attach_ibr(structure, &ibr);
+    }
+
+    if(config.validate) {
+        fork = &fork_validate<S>;
+    }
+    else if(config.producers > 0) {
+        fork = &fork_role<S>;
+    }
+    else if(config.workload != phased_workload) {
+        fork = &fork_mixed<S>;
+    }
+
+    atomic<int> producers_done(0);
+    atomic<int> phase(starting_phase);
+    op_counter* counters = new op_counter[number_of_threads];
+
+    for(int i = 0; i < number_of_threads; i++) {
+        counters[i].ops.store(0, RELAXED);
+    }
+
+    Latency_Histogram* histograms = NULL;
+
+    if(config.latency) {
+        histograms = new Latency_Histogram[operation_types * number_of_threads];
+    }
+
+    Perf_Counters* perf = NULL;
+
+    if(config.counters) {
+        perf = new Perf_Counters[number_of_threads];
+    }
+
+    vector<history_event>* histories = NULL;
+
+    if(config.validate) {
+        histories = new vector<history_event>[number_of_threads];
+    }
+
+    // Arguments live until the threads are joined
+    DS_Tester_args* args = new DS_Tester_args[number_of_threads];
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+		DS_Tester_args* dstArgs = &args[i];
+		dstArgs->barrier = &barrier;
+		dstArgs->lock = &lock;
+        dstArgs->structure = structure;
+        dstArgs->ebr = &ebr;
+        dstArgs->qsbr = &qsbr;
+        dstArgs->ibr = &ibr;
+        dstArgs->reclamation = reclamation_scheme;
+        dstArgs->stall_ms = config.stall_ms;
+		dstArgs->number_of_threads = number_of_threads;
+        dstArgs->iterations = config.iterations;
+        dstArgs->batch = config.batch;
+        dstArgs->workload = config.workload;
+        dstArgs->push_percent = config.push_percent;
+        dstArgs->prefill = config.prefill;
+        dstArgs->producers = config.producers;
+        dstArgs->producers_done = &producers_done;
+        dstArgs->consumed = 0;
+        dstArgs->latency_sum = 0;
+        dstArgs->latency_max = 0;
+        dstArgs->counter = &counters[i];
+        dstArgs->histograms = histograms != NULL ? &histograms[i * operation_types] : NULL;
+        dstArgs->perf = perf != NULL ? &perf[i] : NULL;
+        dstArgs->perf_error = 0;
+        dstArgs->hitm_raw = config.hitm_raw;
+        dstArgs->duration_ms = config.duration_ms;
+        dstArgs->phase = &phase;
+        dstArgs->seen_phase = starting_phase;
+        dstArgs->history = histories != NULL ? &histories[i] : NULL;
+		dstArgs->tid = i;
+
+    }
+
+	int ret; size_t i;
+    timer_args timer;
+    pthread_t timer_thread;
+    uint64_t* measured_ops = NULL;
+
+    if(config.duration_ms > 0) {
+
+        measured_ops = new uint64_t[number_of_threads];
+        timer.counters = counters;
+        timer.number_of_threads = number_of_threads;
+        timer.warmup_ms = config.warmup_ms;
+        timer.duration_ms = config.duration_ms;
+        timer.phase = &phase;
+        timer.measured_ops = measured_ops;
+
+        ret = pthread_create(&timer_thread, NULL, &run_timer, (void*)&timer);
+
+        if(ret){
+
+            printf("ERROR; pthread_create: %d\n", ret);
+            exit(-1);
+
+        }
+    }
+
+    atomic<bool> stop_monitor(false);
+    vector<throughput_sample> samples;
+    monitor_args monitor;
+    pthread_t monitor_thread;
+
+    if(config.interval_ms > 0) {
+
+        monitor.counters = counters;
+        monitor.number_of_threads = number_of_threads;
+        monitor.interval_ms = config.interval_ms;
+        monitor.stop = &stop_monitor;
+        monitor.samples = &samples;
+
+        ret = pthread_create(&monitor_thread, NULL, &monitor_throughput, (void*)&monitor);
+
+        if(ret){
+
+            printf("ERROR; pthread_create: %d\n", ret);
+            exit(-1);
+
+        }
+    }
+
+    Thread_Placement placement(config.pin);
+    cpu_set_t caller_affinity;
+    pthread_attr_t attributes;
+
+    if(placement.valid()) {
+
+        pthread_getaffinity_np(pthread_self(), sizeof(caller_affinity), &caller_affinity);
+        ret = placement.pin(pthread_self(), 0);
+
+        if(ret){
+
+            printf("ERROR; pthread_setaffinity_np: %d\n", ret);
+            exit(-1);
+
+        }
+    }
+
+	// launch threads
+	for(i=1; i < number_of_threads; i++){
+
+        pthread_attr_init(&attributes);
+
+        if(placement.valid()) {
+            placement.pin(&attributes, i);
+        }
+
+        ret = pthread_create(&threads[i], &attributes, fork, (void*)&args[i]);
+        pthread_attr_destroy(&attributes);
+
+		if(ret){
+
+			printf("ERROR; pthread_create: %d\n", ret);
+			exit(-1);
+
+		}
+	}
+
+	// master also calls thread_main
+    fork((void*)&args[0]);
+
+	// join threads
+	for(size_t i=1; i<number_of_threads; i++){
+
+		ret = pthread_join(threads[i],NULL);
+
+		if(ret){
+
+			printf("ERROR; pthread_join: %d\n", ret);
+			exit(-1);
+
+		}
+	}
+
+    if(placement.valid()) {
+        pthread_setaffinity_np(pthread_self(), sizeof(caller_affinity), &caller_affinity);
+    }
+
+    if(config.interval_ms > 0) {
+
+        stop_monitor.store(true, RELEASE);
+        ret = pthread_join(monitor_thread, NULL);
+
+        if(ret){
+
+            printf("ERROR; pthread_join: %d\n", ret);
+            exit(-1);
+
+        }
+    }
+
+    if(config.duration_ms > 0) {
+
+        ret = pthread_join(timer_thread, NULL);
+
+        if(ret){
+
+            printf("ERROR; pthread_join: %d\n", ret);
+            exit(-1);
+
+        }
+    }
+
+    unsigned long long total_ops = 0;
+    unsigned long long min_thread_ops = ULLONG_MAX;
+    unsigned long long max_thread_ops = 0;
+
+    for(int i = 0; i < number_of_threads; i++) {
+        unsigned long long ops = measured_ops != NULL ? measured_ops[i] : counters[i].ops.load(RELAXED);
+        total_ops += ops;
+        min_thread_ops = ops < min_thread_ops ? ops : min_thread_ops;
+        max_thread_ops = ops > max_thread_ops ? ops : max_thread_ops;
+    }
+
+    delete [] counters;
+    delete [] measured_ops;
+
+    unsigned long long consumed = 0;
+    unsigned long long latency_sum = 0;
+    unsigned long long latency_max = 0;
+    int perf_error = 0;
+
+    for(int i = 0; i < number_of_threads; i++) {
+        perf_error = perf_error == 0 ? args[i].perf_error : perf_error;
+        consumed += args[i].consumed;
+        latency_sum += args[i].latency_sum;
+        latency_max = args[i].latency_max > latency_max ? args[i].latency_max : latency_max;
+    }
+
+    delete [] args;
+
+    unsigned long long elapsed_ns;
+	elapsed_ns = (finish.tv_sec-start.tv_sec)*1000000000 + (finish.tv_nsec-start.tv_nsec);
+
+    if(config.duration_ms > 0) {
+        elapsed_ns = (timer.measure_end.tv_sec - timer.measure_start.tv_sec) * 1000000000ULL +
+            (timer.measure_end.tv_nsec - timer.measure_start.tv_nsec);
+    }
+
+    DS_Tester_result result;
+    result.elapsed_ns = elapsed_ns;
+    result.operations = total_ops;
+    result.valid = true;
+
+    validation_report validation;
+
+    if(histories != NULL) {
+
+        History_Checker checker(histories, number_of_threads, structure_order(config.data_structure));
+        validation = checker.check();
+        result.valid = History_Checker::passed(validation);
+
+        delete [] histories;
+
+    }
+
+    // A sweep only keeps the measurements
+    if(config.quiet) {
+        delete [] histograms;
+        delete [] perf;
+        return result;
+    }
+
+    if(config.duration_ms > 0) {
+        printf("Warmup (ms): %d\n", config.warmup_ms);
+        printf("Duration (ms): %d\n", config.duration_ms);
+    }
+
+	printf("Elapsed (ns): %llu\n",elapsed_ns);
+
+    if(placement.valid()) {
+        printf("Placement: %s\n", placement.describe(number_of_threads).c_str());
+    }
+
+    for(size_t s = 0; s < samples.size(); s++) {
+        printf("Interval %zu: %.0f ops/s (thread min %llu, max %llu ops)\n", s + 1,
+            samples[s].ops * 1e9 / samples[s].elapsed_ns, (unsigned long long)samples[s].min_thread_ops,
+            (unsigned long long)samples[s].max_thread_ops);
+    }
+
+    printf("Operations: %llu (thread min %llu, max %llu)\n", total_ops, min_thread_ops, max_thread_ops);
+    printf("Throughput (ops/s): %.0f\n", elapsed_ns > 0 ? total_ops * 1e9 / elapsed_ns : 0.0);
+
+    if(histograms != NULL) {
+
+        Latency_Histogram merged;
+
+        for(int type = 0; type < operation_types; type++) {
+
+            merged.clear();
+
+            for(int i = 0; i < number_of_threads; i++) {
+                merged.merge(histograms[i * operation_types + type]);
+            }
+
+            printf("%s latency (ns): p50 %llu, p90 %llu, p99 %llu, p99.9 %llu, max %llu (%llu ops)\n",
+                operation_name(config.data_structure, (operation_type)type),
+                (unsigned long long)merged.percentile(50), (unsigned long long)merged.percentile(90),
+                (unsigned long long)merged.percentile(99), (unsigned long long)merged.percentile(99.9),
+                (unsigned long long)merged.maximum(), (unsigned long long)merged.count());
+
+        }
+
+        delete [] histograms;
+
+    }
+
+    if(perf != NULL && perf_error != 0) {
+        printf("Hardware counters: unavailable (%s)\n", strerror(perf_error));
+    }
+    else if(perf != NULL) {
+
+        unsigned long long totals[perf_counter_events];
+
+        for(int event = 0; event < perf_counter_events; event++) {
+
+            totals[event] = 0;
+
+            for(int i = 0; i < number_of_threads; i++) {
+                totals[event] += perf[i].value((perf_counter_event)event);
+            }
+
+            if(!perf[0].available((perf_counter_event)event)) {
+                printf("%s: unavailable\n", Perf_Counters::name((perf_counter_event)event));
+            }
+            else {
+                printf("%s: %llu (%.2f per op)\n", Perf_Counters::name((perf_counter_event)event), totals[event],
+                    total_ops > 0 ? (double)totals[event] / total_ops : 0.0);
+            }
+
+        }
+
+        if(perf[0].available(instructions_event) && totals[cycles_event] > 0) {
+            printf("IPC: %.2f\n", (double)totals[instructions_event] / totals[cycles_event]);
+        }
+
+    }
+
+    delete [] perf;
+
+    if(config.producers > 0) {
+        printf("Producers: %d\n", config.producers);
+        printf("Consumers: %d\n", config.consumers);
+        printf("Values consumed: %llu\n", consumed);
+        printf("Mean end to end latency (ns): %.1f\n", consumed > 0 ? (double)latency_sum / consumed : 0.0);
+        printf("Max end to end latency (ns): %llu\n", latency_max);
+    }
+
+    if(config.validate) {
+        report_validation(validation, structure_order(config.data_structure));
+        printf("Validation: %s\n", result.valid ? "passed" : "FAILED");
+    }
+
+    if(config.data_structure.compare("treiber") == 0 || config.data_structure.compare("msQ") == 0 || config.data_structure.compare("sharded") == 0) {
+        size_t peak_unreclaimed;
+
+        switch(reclamation_scheme) {
+
+            case(epoch_based):{
+                peak_unreclaimed = ebr.peak_unreclaimed();
+                break;
+            }
+
+            case(quiescent_state_based):{
+                peak_unreclaimed = qsbr.peak_unreclaimed();
+                break;
+            }
+
+            case(interval_based):{
+                peak_unreclaimed = ibr.peak_unreclaimed();
+                break;
+            }
+        }
+
+        printf("Reclamation: %s\n", config.reclamation.c_str());
+        printf("Peak unreclaimed nodes: %zu\n", peak_unreclaimed);
+    }
+
+    report_statistics(structure);
+
+    return result;
+
+}
 
 /***************************************************************************//**
  * @brief
- *  This is the test method for the DS_Tester class
+ *  Runs the batched test once per batch size
  *
  * @details
- *  tests and analyzes the passed data structure
+ *  Batch sizes double from 1 up to the configured batch size, which is always run last. Every
+ *  batch size gets a fresh data structure, so earlier runs leave nothing behind in the node pool.
+ *  Returns the measurements of the largest batch size.
  *
  * @note
  * 	none
  *
- * @param[in] data
- *  The data structure that will be tested
- * 
- * @param[in] size
- *  The data structure that will be tested
- * 
- * @param[in] number_of_threads
- *  The data structure that will be tested
- * 
- * @param[in] data_structure
- *  The data structure that will be tested
+ * @param[in] fork
+ *  Batched thread body for the data structure
+ *
+ * @param[in] config
+ *  Test settings, batch is the largest batch size in the sweep
  *
  ******************************************************************************/
-void DS_Tester::test(int iterations, int number_of_threads, string data_structure) {
-
-    Locks lock(LOCK);
-	Barriers barrier(BARRIER, number_of_threads);    
-    T_stack t_stack(number_of_threads, iterations);
-    SGL_stack s_stack(number_of_threads, iterations);
-    MS_queue m_queue;
-    SGL_Queue s_queue(number_of_threads);
-    atomic<int> epoch;
-    atomic<int>* reservations;
+template<typename S>
+static DS_Tester_result batch_sweep(pthread_t* threads, void* (*fork)(void*), DS_Tester_config config) {
 
-    epoch.store(0, ACQ);
-    reservations = new atomic<int>[number_of_threads];
-    
-    
+    DS_Tester_result result;
+    int max_batch = config.batch;
+    config.batch = 1;
 
-	// launch threads
-	int ret; size_t i;
-	for(i=1; i < number_of_threads; i++){
+    while(true) {
 
-		DS_Tester_args* dstArgs = new DS_Tester_args;
-		dstArgs->barrier = &barrier;
-		dstArgs->lock = &lock;
-        dstArgs->t_stack = &t_stack;
-        dstArgs->s_stack = &s_stack;
-        dstArgs->m_queue = &m_queue;
-        dstArgs->s_queue = &s_queue;
-        dstArgs->epoch = &epoch;
-        dstArgs->reservations = reservations;
-		dstArgs->number_of_threads = number_of_threads;
-        dstArgs->iterations = iterations;
-		dstArgs->tid = i;
-		
-        //////////// Treiber Stack ////////////
-        if(data_structure.compare("treiber") == 0) {
+        printf("Batch size: %d\n", config.batch);
 
-            ret = pthread_create(&threads[i], NULL, &fork_Treiber, (void*)dstArgs);
+        S structure(config.number_of_threads);
+        result = run_test(threads, &structure, fork, config);
 
+        if(config.batch >= max_batch) {
+            break;
         }
 
-        //////////// M&S Queue ////////////
-        else if(data_structure.compare("msQ") == 0){
+        config.batch = 2 * config.batch < max_batch ? 2 * config.batch : max_batch;
 
-            ret = pthread_create(&threads[i], NULL, &fork_MS, (void*)dstArgs);
+    }
 
-        }
-        //////////// SGL Stack ////////////
-        else if(data_structure.compare("sglS") == 0){
+    return result;
 
-            ret = pthread_create(&threads[i], NULL, &fork_SGL_Stack, (void*)dstArgs);
+}
 
-        }
-        //////////// SGL Queue ////////////
-        else if(data_structure.compare("sglQ") == 0){
+/***************************************************************************//**
+ * @brief
+ *  Returns the shard selection named on the command line
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static shard_selection shard_choice(string shard) {
 
-            ret = pthread_create(&threads[i], NULL, &fork_SGL_Queue, (void*)dstArgs);
+    return shard.compare("cpu") == 0 ? cpu_shard : thread_shard;
 
-        }
+}
 
-        else {
+/***************************************************************************//**
+ * @brief
+ *  Returns how many shards the sharded stack gets
+ *
+ * @details
+ *  One shard per thread when shards are picked by thread id, one per online CPU when they are
+ *  picked by CPU
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static int shard_count(int number_of_threads, string shard) {
 
-            assert(false);
+    if(shard_choice(shard) == cpu_shard) {
 
-        }
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
 
-		if(ret){
+        return cpus > 0 ? (int)cpus : 1;
 
-			printf("ERROR; pthread_create: %d\n", ret);
-			exit(-1);
+    }
 
-		}
-        delete dstArgs;
-	}
+    return number_of_threads;
 
-	DS_Tester_args* masterArgs = new DS_Tester_args;
-	masterArgs->barrier = &barrier;
-	masterArgs->lock = &lock;
-    masterArgs->t_stack = &t_stack;
-    masterArgs->s_stack = &s_stack;
-    masterArgs->m_queue = &m_queue;
-    masterArgs->s_queue = &s_queue;
-    masterArgs->epoch = &epoch;
-    masterArgs->reservations = reservations;
-	masterArgs->number_of_threads = number_of_threads;
-    masterArgs->iterations = iterations;
-	masterArgs->tid = 0;
+}
 
-	// master also calls thread_main
+/***************************************************************************//**
+ * @brief
+ *  This is the test method for the DS_Tester class
+ *
+ * @details
+ *  Builds the requested variant of the data structure and tests it, returning what the test measured
+ *
+ * @note
+ * 	Only pass variants the data structure supports
+ *
+ * @param[in] config
+ *  Test settings
+ *
+ ******************************************************************************/
+DS_Tester_result DS_Tester::test(DS_Tester_config config) {
+
+    string data_structure = config.data_structure;
+    string variant = config.variant;
+    int number_of_threads = config.number_of_threads;
+    DS_Tester_result result;
+
+    if(!config.quiet) {
+        printf("Variant: %s\n", variant.c_str());
+    }
 
     //////////// Treiber Stack ////////////
     if(data_structure.compare("treiber") == 0) {
 
-        fork_Treiber((void*)masterArgs);
+        if(config.batch > 0 && variant.compare("elimination") == 0) {
+            result = batch_sweep<T_stack<elimination_variant> >(threads, &fork_Treiber_bulk<T_stack<elimination_variant> >, config);
+        }
+        else if(config.batch > 0) {
+            result = batch_sweep<T_stack<base_variant> >(threads, &fork_Treiber_bulk<T_stack<base_variant> >, config);
+        }
+        else if(variant.compare("elimination") == 0) {
+            T_stack<elimination_variant> t_stack(number_of_threads);
+            result = run_test(threads, &t_stack, &fork_Treiber<T_stack<elimination_variant> >, config);
+        }
+        else {
+            T_stack<base_variant> t_stack(number_of_threads);
+            result = run_test(threads, &t_stack, &fork_Treiber<T_stack<base_variant> >, config);
+        }
 
     }
 
     //////////// M&S Queue ////////////
     else if(data_structure.compare("msQ") == 0){
 
-        fork_MS((void*)masterArgs);
+        if(config.batch > 0 && variant.compare("elimination") == 0) {
+            result = batch_sweep<MS_queue<elimination_variant> >(threads, &fork_MS_bulk<MS_queue<elimination_variant> >, config);
+        }
+        else if(config.batch > 0) {
+            result = batch_sweep<MS_queue<base_variant> >(threads, &fork_MS_bulk<MS_queue<base_variant> >, config);
+        }
+        else if(variant.compare("elimination") == 0) {
+            MS_queue<elimination_variant> m_queue(number_of_threads);
+            result = run_test(threads, &m_queue, &fork_MS<MS_queue<elimination_variant> >, config);
+        }
+        else {
+            MS_queue<base_variant> m_queue(number_of_threads);
+            result = run_test(threads, &m_queue, &fork_MS<MS_queue<base_variant> >, config);
+        }
+
+    }
+    //////////// Sharded Stack ////////////
+    else if(data_structure.compare("sharded") == 0){
+
+        Sharded_stack sharded_stack(number_of_threads, shard_count(number_of_threads, config.shard), shard_choice(config.shard));
+        result = run_test(threads, &sharded_stack, &fork_Treiber<Sharded_stack>, config);
+
+    }
+    //////////// Tagged Treiber Stack ////////////
+    else if(data_structure.compare("tagged") == 0){
+
+        Tagged_T_stack tagged_stack;
+        result = run_test(threads, &tagged_stack, &fork_Tagged<Tagged_T_stack>, config);
 
     }
     //////////// SGL Stack ////////////
     else if(data_structure.compare("sglS") == 0){
 
-        fork_SGL_Stack((void*)masterArgs);
+        if(variant.compare("elimination") == 0) {
+            SGL_stack<elimination_variant> s_stack(number_of_threads);
+            result = run_test(threads, &s_stack, &fork_SGL_Stack<SGL_stack<elimination_variant> >, config);
+        }
+        else if(variant.compare("unrolled") == 0) {
+            SGL_stack<unrolled_variant> s_stack(number_of_threads);
+            result = run_test(threads, &s_stack, &fork_SGL_Stack<SGL_stack<unrolled_variant> >, config);
+        }
+        else if(variant.compare("fc") == 0) {
+            SGL_stack<flat_combining_variant> s_stack(number_of_threads);
+            result = run_test(threads, &s_stack, &fork_SGL_Stack<SGL_stack<flat_combining_variant> >, config);
+        }
+        else {
+            SGL_stack<base_variant> s_stack(number_of_threads);
+            result = run_test(threads, &s_stack, &fork_SGL_Stack<SGL_stack<base_variant> >, config);
+        }
 
     }
     //////////// SGL Queue ////////////
     else if(data_structure.compare("sglQ") == 0){
 
-        fork_SGL_Queue((void*)masterArgs);
+        if(variant.compare("twolock") == 0) {
+            SGL_Queue<two_lock_variant> s_queue(number_of_threads, config.lock, config.lock);
+            result = run_test(threads, &s_queue, &fork_SGL_Queue<SGL_Queue<two_lock_variant> >, config);
+        }
+        else if(variant.compare("unrolled") == 0) {
+            SGL_Queue<unrolled_variant> s_queue(number_of_threads);
+            result = run_test(threads, &s_queue, &fork_SGL_Queue<SGL_Queue<unrolled_variant> >, config);
+        }
+        else if(variant.compare("fc") == 0) {
+            SGL_Queue<flat_combining_variant> s_queue(number_of_threads);
+            result = run_test(threads, &s_queue, &fork_SGL_Queue<SGL_Queue<flat_combining_variant> >, config);
+        }
+        else {
+            SGL_Queue<base_variant> s_queue(number_of_threads);
+            result = run_test(threads, &s_queue, &fork_SGL_Queue<SGL_Queue<base_variant> >, config);
+        }
 
     }
 
@@ -688,24 +2654,93 @@ void DS_Tester::test(int iterations, int number_of_threads, string data_structur
 
     }
 
-	// join threads
-	for(size_t i=1; i<number_of_threads; i++){
+    return result;
 
-		ret = pthread_join(threads[i],NULL);
+}
 
-		if(ret){
+/***************************************************************************//**
+ * @brief
+ *  Returns whether a data structure has the given optimization variant
+ *
+ * @details
+ *  Every structure has the base variant. Lock free structures have no lock to combine under or
+ *  chunks to fill, and only a queue can split its lock in two.
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+bool DS_Tester::supports(string data_structure, string variant) {
 
-			printf("ERROR; pthread_join: %d\n", ret);
-			exit(-1);
+    if(variant.compare("elimination") == 0) {
+        return data_structure.compare("treiber") == 0 || data_structure.compare("msQ") == 0 || data_structure.compare("sglS") == 0;
+    }
+    else if(variant.compare("fc") == 0 || variant.compare("unrolled") == 0) {
+        return data_structure.compare("sglS") == 0 || data_structure.compare("sglQ") == 0;
+    }
+    else if(variant.compare("twolock") == 0) {
+        return data_structure.compare("sglQ") == 0;
+    }
 
-		}
-	}
+    return variant.compare("base") == 0;
 
-    delete [] reservations;
-    delete masterArgs;
+}
 
-    unsigned long long elapsed_ns;
-	elapsed_ns = (finish.tv_sec-start.tv_sec)*1000000000 + (finish.tv_nsec-start.tv_nsec);
-	printf("Elapsed (ns): %llu\n",elapsed_ns);
+/***************************************************************************//**
+ * @brief
+ *  Compares how the stacks scale with the number of threads
+ *
+ * @details
+ *  Runs the Treiber stack, the SGL stack and the sharded stack at 1, 2, 4, ... threads up to
+ *  the configured number of threads, which is always run last. Each run gets a fresh stack.
+ *
+ * @note
+ * 	The base variants are used, so only the single top or single lock is being compared
+ *
+ * @param[in] config
+ *  Test settings, number_of_threads is the largest number of threads
+ *
+ ******************************************************************************/
+void DS_Tester::scaling_test(DS_Tester_config config) {
+
+    int max_threads = config.number_of_threads;
+    config.number_of_threads = 1;
+    config.stall_ms = 0;
+    config.batch = 0;
+    config.producers = 0;
+
+    while(true) {
+
+        int number_of_threads = config.number_of_threads;
+        printf("Threads: %d\n", number_of_threads);
+
+        {
+            printf("Structure: treiber\n");
+            config.data_structure = "treiber";
+            T_stack<base_variant> t_stack(number_of_threads);
+            run_test(threads, &t_stack, &fork_Treiber<T_stack<base_variant> >, config);
+        }
+
+        {
+            printf("Structure: sglS\n");
+            config.data_structure = "sglS";
+            SGL_stack<base_variant> s_stack(number_of_threads);
+            run_test(threads, &s_stack, &fork_SGL_Stack<SGL_stack<base_variant> >, config);
+        }
 
-}	
\ No newline at end of file
+        {
+            printf("Structure: sharded\n");
+            config.data_structure = "sharded";
+            Sharded_stack sharded_stack(number_of_threads, shard_count(number_of_threads, config.shard), shard_choice(config.shard));
+            run_test(threads, &sharded_stack, &fork_Treiber<Sharded_stack>, config);
+        }
+
+        if(number_of_threads >= max_threads) {
+            break;
+        }
+
+        config.number_of_threads = 2 * number_of_threads < max_threads ? 2 * number_of_threads : max_threads;
+
+    }
+
+}
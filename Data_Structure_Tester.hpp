@@ -17,7 +17,6 @@
 #include <string>
 #include <vector>
 #include <cmath>
-#include <map>
 #include <atomic>
 #include <limits.h>
 #include "Locks.hpp"
@@ -26,6 +25,16 @@
 #include "Treiber_Stack.hpp"
 #include "SGL_Queue.hpp"
 #include "SGL_Stack.hpp"
+#include "Tagged_Treiber_Stack.hpp"
+#include "Sharded_Stack.hpp"
+#include "EBR.hpp"
+#include "QSBR.hpp"
+#include "IBR.hpp"
+#include "Latency_Histogram.hpp"
+#include "Thread_Placement.hpp"
+#include "Perf_Counters.hpp"
+#include "History_Checker.hpp"
+#include <unistd.h>
 
 //***********************************************************************************
 // defined files
@@ -34,29 +43,174 @@ using std::string;
 using std::atomic;
 using std::cout;
 using std::endl;
-using std::multimap;
+using std::vector;
 
 #define BARRIER "sense"
 #define LOCK "pthread"
 #define ACQREL std::memory_order_acq_rel
 #define ACQ std::memory_order_acquire
+#define RELEASE std::memory_order_release
+#define RELAXED std::memory_order_relaxed
+#define QUIESCENT_INTERVAL 16
+
+// Latency stamps count 16 ns ticks in 31 bits, so a stamp is never the -1 empty marker and
+// latencies only wrap after about 34 seconds
+#define STAMP_SHIFT 4
+#define STAMP_MASK 0x7FFFFFFFU
 
 //***********************************************************************************
 // data structure prototypes
 //***********************************************************************************
+enum reclamation_type {
+
+    epoch_based,
+    quiescent_state_based,
+    interval_based
+
+};
+
+// Phased pushes every value then pops until empty, mixed picks each operation at random and
+// pair follows every insert with a remove
+enum workload_type {
+
+    phased_workload,
+    mixed_workload,
+    pair_workload
+
+};
+
+// Phases of a duration run, the timer thread moves the run from one to the next
+enum run_phase {
+
+    starting_phase,
+    warmup_phase,
+    measure_phase,
+    stopped_phase
+
+};
+
+// Kinds of operation timed by the latency histograms, each thread keeps one histogram per kind
+enum operation_type {
+
+    insert_operation,
+    remove_operation,
+    operation_types
+
+};
+
+// Everything the command line can change about a test
+struct DS_Tester_config {
+
+    int iterations;
+    int number_of_threads;
+    string data_structure;
+    string variant;
+    string reclamation;
+    int stall_ms;
+    int batch;
+    string shard;
+    workload_type workload;
+    int push_percent;
+    int prefill;
+    int producers;
+    int consumers;
+    int interval_ms;
+    bool latency;
+    string pin;
+    bool counters;
+    uint64_t hitm_raw;
+    string lock;
+    string barrier;
+    bool quiet;
+    int duration_ms;
+    int warmup_ms;
+    bool validate;
+
+};
+
+// What one test run measured
+struct DS_Tester_result {
+
+    unsigned long long elapsed_ns;
+    unsigned long long operations;
+    bool valid;
+
+};
+
+// Operations a thread has completed, alone on its cache line so counting never shares a line.
+// Only the owning thread writes it, the monitor thread reads it while the test runs.
+struct alignas(CACHE_LINE_SIZE) op_counter {
+
+    atomic<uint64_t> ops;
+
+};
+
+// Operations completed during one monitor interval, with the slowest and fastest thread's share
+struct throughput_sample {
+
+    uint64_t elapsed_ns;
+    uint64_t ops;
+    uint64_t min_thread_ops;
+    uint64_t max_thread_ops;
+
+};
+
+// Shared with the timer thread of a duration run, which leaves the measured window's
+// operation counts and clock readings here
+struct timer_args {
+
+    op_counter* counters;
+    int number_of_threads;
+    int warmup_ms;
+    int duration_ms;
+    atomic<int>* phase;
+    uint64_t* measured_ops;
+    struct timespec measure_start;
+    struct timespec measure_end;
+
+};
+
+struct monitor_args {
+
+    op_counter* counters;
+    int number_of_threads;
+    int interval_ms;
+    atomic<bool>* stop;
+    vector<throughput_sample>* samples;
+
+};
+
 struct DS_Tester_args {
 	
 	Locks *lock;
     Barriers *barrier;
-    T_stack* t_stack;
-    SGL_stack* s_stack;
-    MS_queue* m_queue;
-    SGL_Queue* s_queue;
-    atomic<int>* epoch;
-    atomic<int>* reservations;
+    void* structure;
+    EBR* ebr;
+    QSBR* qsbr;
+    IBR* ibr;
+    reclamation_type reclamation;
+    int stall_ms;
 	int tid;
 	int number_of_threads;
     int iterations;
+    int batch;
+    workload_type workload;
+    int push_percent;
+    int prefill;
+    int producers;
+    atomic<int>* producers_done;
+    uint64_t consumed;
+    uint64_t latency_sum;
+    uint64_t latency_max;
+    op_counter* counter;
+    Latency_Histogram* histograms;
+    Perf_Counters* perf;
+    int perf_error;
+    uint64_t hitm_raw;
+    int duration_ms;
+    atomic<int>* phase;
+    int seen_phase;
+    vector<history_event>* history;
 
 };
 
@@ -68,7 +222,9 @@ class DS_Tester {
     public:
     DS_Tester(int number_of_threads);
     ~DS_Tester();
-    void test(int iterations, int number_of_threads, string data_structure);
+    DS_Tester_result test(DS_Tester_config config);
+    void scaling_test(DS_Tester_config config);
+    static bool supports(string data_structure, string variant);
 
 };
 
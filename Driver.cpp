@@ -11,44 +11,202 @@
 //***********************************************************************************
 #include "Driver.hpp"
 
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+static const char* structure_names[] = {"treiber", "tagged", "sharded", "msQ", "sglS", "sglQ"};
+static const char* variant_names[] = {"base", "elimination", "fc", "twolock", "unrolled"};
+static const char* lock_names[] = {"pthread", "tas", "ttas", "ticket"};
+static const char* barrier_names[] = {"sense", "pthread"};
+
+/***************************************************************************//**
+ * @brief
+ *  Splits a comma separated list from the command line
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static vector<string> split_list(string list) {
+
+    vector<string> entries;
+    std::stringstream stream(list);
+    string entry;
+
+    while(std::getline(stream, entry, ',')) {
+        entries.push_back(entry);
+    }
+
+    return entries;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns whether every entry of a comma separated list is one of the given names
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  An empty list is invalid
+ *
+ ******************************************************************************/
+static bool valid_list(string list, const char* names[], int count) {
+
+    vector<string> entries = split_list(list);
+
+    for(size_t i = 0; i < entries.size(); i++) {
+
+        bool found = false;
+
+        for(int j = 0; j < count; j++) {
+            found = found || entries[i].compare(names[j]) == 0;
+        }
+
+        if(!found) {
+            return false;
+        }
+
+    }
+
+    return !entries.empty();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Parses a length of time from the command line into milliseconds
+ *
+ * @details
+ *  Takes a number followed by ms, s or m. A plain number is seconds.
+ *
+ * @note
+ *  Returns -1 if the time does not parse
+ *
+ ******************************************************************************/
+static int parse_time_ms(string time) {
+
+    char* unit;
+    double value = strtod(time.c_str(), &unit);
+
+    if(unit == time.c_str() || value < 0) {
+        return -1;
+    }
+
+    string suffix = unit;
+    double ms;
+
+    if(suffix.compare("ms") == 0) {
+        ms = value;
+    }
+    else if(suffix.empty() || suffix.compare("s") == 0) {
+        ms = value * 1000;
+    }
+    else if(suffix.compare("m") == 0) {
+        ms = value * 60000;
+    }
+    else {
+        return -1;
+    }
+
+    return ms < INT_MAX ? (int)ms : -1;
+
+}
+
 //***********************************************************************************
 // functions
 //***********************************************************************************
 
 /***************************************************************************//**
  * @brief
- *  This is main
+ *  Runs the test described by one list of arguments
  *
  * @details
- *  Parses the command line arguments, making sure syntax and arguments are correct, then calling 
- *  the test method
+ *  Parses the arguments, making sure syntax and arguments are correct, then calling the test
+ *  method. Returns the exit status of the run. When only checking, everything is parsed and
+ *  checked but nothing is run.
  *
  * @note
- * none
+ *  Called once for the command line, or once per scenario of a scenario file
+ *
+ * @param[in] check_only
+ *  Stop once the arguments are known to be valid
  *
  ******************************************************************************/
-int main(int argc, char* argv[]){
-	
-	// parse args
-	if(argc != 2 && argc !=6){
-		
-        cout << argc << endl;
-		printf("Error\nUsage: concurrent_structures [--name] [-t NUM_THREADS] [-i NUM_ITERATIONS] [--structure=<treiber,msQ,sglS,sglQ>]\n\n");
-		return 1;
-	}
+static int run_command(int argc, char* argv[], bool check_only){
 
 	// Variable declarations
 	int c;
-	size_t NUM_THREADS;
+	size_t NUM_THREADS = 1;
 	string data_structure;
-	int NUM_ITERATIONS;
+	string variant = "base";
+	string reclamation = "ebr";
+	int stall_ms = 0;
+	int batch = 0;
+	string shard = "tid";
+	bool scaling = false;
+	string workload = "phased";
+	int push_percent = 50;
+	int prefill = 0;
+	int producers = 0;
+	int consumers = 0;
+	int interval_ms = 0;
+	int duration_ms = 0;
+	int warmup_ms = 0;
+	bool validate = false;
+	bool latency = false;
+	string pin;
+	bool counters = false;
+	uint64_t hitm_raw = PERF_NO_RAW_EVENT;
+	string lock = LOCK;
+	string barrier = BARRIER;
+	string thread_list;
+	bool sweep = false;
+	int repetitions = 5;
+	int discard = 1;
+	string format = "csv";
+	string output;
+	int NUM_ITERATIONS = 0;
 	
+    // Start over, every scenario parses its own arguments
+    optind = 0;
+
     while(true) {
 
         // Creating the long options
         static struct option long_options[] = {
             {"name",   no_argument,         0,  'n' },
 			{"structure",   required_argument,   0,  's' },
+			{"variant",   required_argument,   0,  'v' },
+			{"reclaim",   required_argument,   0,  'r' },
+			{"stall",   required_argument,   0,  'l' },
+			{"batch",   required_argument,   0,  'b' },
+			{"shard",   required_argument,   0,  'h' },
+			{"scaling",   no_argument,   0,  'c' },
+			{"workload",   required_argument,   0,  'w' },
+			{"mix",   required_argument,   0,  'm' },
+			{"prefill",   required_argument,   0,  'p' },
+			{"producers",   required_argument,   0,  'P' },
+			{"consumers",   required_argument,   0,  'C' },
+			{"interval",   required_argument,   0,  'I' },
+			{"latency",   no_argument,   0,  'L' },
+			{"pin",   required_argument,   0,  'a' },
+			{"counters",   optional_argument,   0,  'k' },
+			{"lock",   required_argument,   0,  'o' },
+			{"barrier",   required_argument,   0,  'B' },
+			{"sweep",   no_argument,   0,  'S' },
+			{"repeat",   required_argument,   0,  'R' },
+			{"discard",   required_argument,   0,  'D' },
+			{"format",   required_argument,   0,  'F' },
+			{"output",   required_argument,   0,  'O' },
+			{"duration",   required_argument,   0,  'u' },
+			{"warmup",   required_argument,   0,  'U' },
+			{"validate",   no_argument,   0,  'V' },
+			{"scenarios",   required_argument,   0,  'f' },
             {0, 0, 0, 0}
         };
 
@@ -77,14 +235,288 @@ int main(int argc, char* argv[]){
                 data_structure = optarg;
 
                 // If invalid data structure input is entered
-                if(data_structure.compare("treiber") != 0 && data_structure.compare("msQ") != 0 && data_structure.compare("sglS") != 0 && data_structure.compare("sglQ") != 0) {
-                    printf("\nInvalid data structure\nUsage: concurrent_structures [--name] [-t NUM_THREADS] [-i NUM_ITERATIONS] [--structure=<treiber,msQ,sglS,sglQ>]\n\n");
+                if(!valid_list(data_structure, structure_names, sizeof(structure_names) / sizeof(structure_names[0]))) {
+                    printf("\nInvalid data structure\n" USAGE);
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Chosen optimization variant of the data structure
+            case 'v': {
+
+                variant = optarg;
+
+                if(!valid_list(variant, variant_names, sizeof(variant_names) / sizeof(variant_names[0]))) {
+                    printf("\nInvalid variant\n" USAGE);
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Chosen reclamation scheme for the lock free structures
+            case 'r': {
+
+                reclamation = optarg;
+
+                if(reclamation.compare("ebr") != 0 && reclamation.compare("qsbr") != 0 && reclamation.compare("ibr") != 0) {
+                    printf("\nInvalid reclamation scheme\n" USAGE);
                     return 1;
                 }
 				break;
 
             }
 
+            // Milliseconds the last thread stalls inside an operation
+            case 'l': {
+
+                stall_ms = atoi(optarg);
+				break;
+
+            }
+
+            // Largest batch size of the bulk operation sweep
+            case 'b': {
+
+                batch = atoi(optarg);
+				break;
+
+            }
+
+            // How the sharded stack picks a thread's home shard
+            case 'h': {
+
+                shard = optarg;
+
+                if(shard.compare("tid") != 0 && shard.compare("cpu") != 0) {
+                    printf("\nInvalid shard selection\n" USAGE);
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Compare the stacks at 1, 2, 4, ... up to NUM_THREADS threads
+            case 'c': {
+
+                scaling = true;
+				break;
+
+            }
+
+            // Order the threads perform their inserts and removes in
+            case 'w': {
+
+                workload = optarg;
+
+                if(workload.compare("phased") != 0 && workload.compare("mixed") != 0 && workload.compare("pair") != 0) {
+                    printf("\nInvalid workload\n" USAGE);
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Percent of the mixed workload's operations that are inserts
+            case 'm': {
+
+                push_percent = atoi(optarg);
+
+                if(push_percent < 0 || push_percent > 100) {
+                    printf("\nInvalid mix, the insert percentage must be between 0 and 100\n\n");
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Values inserted before the clock starts
+            case 'p': {
+
+                prefill = atoi(optarg);
+				break;
+
+            }
+
+            // Threads that only insert, each inserts NUM_ITERATIONS values
+            case 'P': {
+
+                producers = atoi(optarg);
+				break;
+
+            }
+
+            // Threads that only remove
+            case 'C': {
+
+                consumers = atoi(optarg);
+				break;
+
+            }
+
+            // Milliseconds between throughput samples
+            case 'I': {
+
+                interval_ms = atoi(optarg);
+
+                if(interval_ms <= 0) {
+                    printf("\nInvalid interval, the sampling interval must be at least 1 ms\n\n");
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Time every operation into latency histograms
+            case 'L': {
+
+                latency = true;
+				break;
+
+            }
+
+            // Where each thread runs
+            case 'a': {
+
+                pin = optarg;
+
+                if(!Thread_Placement(pin).valid()) {
+                    printf("\nInvalid pin, the placement must be compact, scatter, smt-first or list:CPUS of CPUs this process may use\n\n");
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Hardware counters, optionally with this CPU model's raw HITM event code
+            case 'k': {
+
+                counters = true;
+
+                if(optarg != NULL) {
+                    hitm_raw = strtoull(optarg, NULL, 0);
+                }
+				break;
+
+            }
+
+            // Lock guarding the lock based structures
+            case 'o': {
+
+                lock = optarg;
+
+                if(!valid_list(lock, lock_names, sizeof(lock_names) / sizeof(lock_names[0]))) {
+                    printf("\nInvalid lock\n" USAGE);
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Barrier the threads start and finish on
+            case 'B': {
+
+                barrier = optarg;
+
+                if(!valid_list(barrier, barrier_names, sizeof(barrier_names) / sizeof(barrier_names[0]))) {
+                    printf("\nInvalid barrier\n" USAGE);
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Run every combination of the listed settings
+            case 'S': {
+
+                sweep = true;
+				break;
+
+            }
+
+            // Kept runs per sweep point
+            case 'R': {
+
+                repetitions = atoi(optarg);
+
+                if(repetitions < 1) {
+                    printf("\nInvalid repeat, every point needs at least one run\n\n");
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Warmup runs thrown away per sweep point
+            case 'D': {
+
+                discard = atoi(optarg);
+
+                if(discard < 0) {
+                    printf("\nInvalid discard, the number of warmup runs can not be negative\n\n");
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Sweep output format
+            case 'F': {
+
+                format = optarg;
+
+                if(format.compare("csv") != 0 && format.compare("json") != 0) {
+                    printf("\nInvalid format\n" USAGE);
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Sweep output file
+            case 'O': {
+
+                output = optarg;
+				break;
+
+            }
+
+            // Run for a length of time instead of a number of iterations
+            case 'u': {
+
+                duration_ms = parse_time_ms(optarg);
+
+                if(duration_ms <= 0) {
+                    printf("\nInvalid duration, give a time such as 500ms, 5s or 1m\n\n");
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Time run before the measured duration starts
+            case 'U': {
+
+                warmup_ms = parse_time_ms(optarg);
+
+                if(warmup_ms < 0) {
+                    printf("\nInvalid warmup, give a time such as 500ms, 5s or 1m\n\n");
+                    return 1;
+                }
+				break;
+
+            }
+
+            // Record every operation and check the histories once the test is over
+            case 'V': {
+
+                validate = true;
+				break;
+
+            }
+
             // Number of iterations
             case 'i': {
 
@@ -98,23 +530,212 @@ int main(int argc, char* argv[]){
 
                 // Chosen name for the output file
                 NUM_THREADS = atoi(optarg);
+                thread_list = optarg;
 				if(NUM_THREADS > 150){
 					printf("ERROR; too many threads\n");
-					exit(-1);
+					return 1;
 				}
 				
 				break;
 
             }
+
+            // Scenario files are only read on their own
+            case 'f': {
+
+                printf("\n--scenarios takes no other options, each scenario lists its own\n\n");
+                return 1;
+
+            }
+
+            // Unknown option or missing argument, getopt already said which
+            default: {
+
+                printf("\n" USAGE);
+                return 1;
+
+            }
         }
 
     }
 
+	// Lists are only meaningful to the sweep
+	if(!sweep && (data_structure.find(',') != string::npos || variant.find(',') != string::npos || lock.find(',') != string::npos ||
+		barrier.find(',') != string::npos || thread_list.find(',') != string::npos)) {
+		printf("\nLists of settings are only accepted with --sweep\n\n");
+		return 1;
+	}
+
+	// Producers and consumers make up all the threads
+	if(producers > 0 || consumers > 0) {
+
+		if(producers <= 0 || consumers <= 0) {
+			printf("\nProducer/consumer mode needs at least one producer and one consumer\n\n");
+			return 1;
+		}
+
+		if(batch > 0 || scaling || workload.compare("phased") != 0) {
+			printf("\nProducer/consumer mode runs its own workload\n\n");
+			return 1;
+		}
+
+		NUM_THREADS = producers + consumers;
+
+		if(NUM_THREADS > 150){
+			printf("ERROR; too many threads\n");
+			return 1;
+		}
+
+	}
+
+	// Only the steady state loops can run until a timer stops them
+	if(duration_ms > 0 && (batch > 0 || (workload.compare("phased") == 0 && producers == 0))) {
+		printf("\nA duration needs --workload=mixed, --workload=pair or producers and consumers\n\n");
+		return 1;
+	}
+
+	if(warmup_ms > 0 && duration_ms == 0) {
+		printf("\nA warmup is only run before a duration\n\n");
+		return 1;
+	}
+
+	// Validation inserts its own numbered values through the generic operations
+	if(validate && (batch > 0 || scaling || producers > 0 || sweep)) {
+		printf("\nValidation can not be combined with --batch, --scaling, producers and consumers or --sweep\n\n");
+		return 1;
+	}
+
+	DS_Tester_config config;
+	config.iterations = NUM_ITERATIONS;
+	config.number_of_threads = NUM_THREADS;
+	config.data_structure = data_structure;
+	config.variant = variant;
+	config.reclamation = reclamation;
+	config.stall_ms = stall_ms;
+	config.batch = batch;
+	config.shard = shard;
+	config.workload = workload.compare("mixed") == 0 ? mixed_workload : workload.compare("pair") == 0 ? pair_workload : phased_workload;
+	config.push_percent = push_percent;
+	config.prefill = prefill;
+	config.producers = producers;
+	config.consumers = consumers;
+	config.interval_ms = interval_ms;
+	config.duration_ms = duration_ms;
+	config.warmup_ms = warmup_ms;
+	config.validate = validate;
+	config.latency = latency;
+	config.pin = pin;
+	config.counters = counters;
+	config.hitm_raw = hitm_raw;
+	config.lock = lock;
+	config.barrier = barrier;
+	config.quiet = false;
+
+	if(sweep) {
+
+		if(batch > 0 || scaling || producers > 0) {
+			printf("\nThe sweep can not be combined with --batch, --scaling or producers and consumers\n\n");
+			return 1;
+		}
+
+		sweep_lists lists;
+		lists.structures = split_list(data_structure);
+		lists.variants = split_list(variant);
+		lists.locks = split_list(lock);
+		lists.barriers = split_list(barrier);
+
+		vector<string> thread_counts = split_list(thread_list);
+		int max_threads = 0;
+
+		for(size_t i = 0; i < thread_counts.size(); i++) {
+
+			int threads = atoi(thread_counts[i].c_str());
+
+			if(threads < 1 || threads > 150) {
+				printf("\nInvalid thread count %s in the sweep\n\n", thread_counts[i].c_str());
+				return 1;
+			}
+
+			lists.threads.push_back(threads);
+			max_threads = threads > max_threads ? threads : max_threads;
+
+		}
+
+		if(lists.structures.empty() || lists.threads.empty()) {
+			printf("\nThe sweep needs --structure and -t\n\n");
+			return 1;
+		}
+
+		if(check_only) {
+			return 0;
+		}
+
+		FILE* out = stdout;
+
+		if(!output.empty()) {
+
+			out = fopen(output.c_str(), "w");
+
+			if(out == NULL) {
+				printf("\nCould not open %s\n\n", output.c_str());
+				return 1;
+			}
+
+		}
+
+		DS_Tester sweepTester(max_threads);
+		Sweep_Runner runner(&sweepTester, config, lists, repetitions, discard, format, out);
+		runner.run();
+
+		if(out != stdout) {
+			fclose(out);
+		}
+
+		return 0;
+
+	}
+
 	DS_Tester dsTester(NUM_THREADS);
 
-	dsTester.test(NUM_ITERATIONS, NUM_THREADS, data_structure);
+	if(scaling) {
+
+		if(check_only) {
+			return 0;
+		}
+
+		dsTester.scaling_test(config);
+		return 0;
+	}
+
+	if(data_structure.empty()) {
+		printf("\nNo data structure was given\n" USAGE);
+		return 1;
+	}
+
+	if(!DS_Tester::supports(data_structure, variant)) {
+		printf("\nVariant %s is not available for %s\n\n", variant.c_str(), data_structure.c_str());
+		return 1;
+	}
+
+	// Only the lock free structures have bulk operations
+	if(batch > 0 && data_structure.compare("treiber") != 0 && data_structure.compare("msQ") != 0) {
+		printf("\nBatched operations are only available for treiber and msQ\n\n");
+		return 1;
+	}
+
+	// The batch sweep has its own phased forks
+	if(batch > 0 && config.workload != phased_workload) {
+		printf("\nBatched operations only run the phased workload\n\n");
+		return 1;
+	}
+
+	if(check_only) {
+		return 0;
+	}
+
+	DS_Tester_result result = dsTester.test(config);
 
-	return 0;
+	return result.valid ? 0 : 1;
 
 }
 
@@ -130,3 +751,184 @@ int main(int argc, char* argv[]){
 
 
 
+
+/***************************************************************************//**
+ * @brief
+ *  Runs every scenario of a scenario file
+ *
+ * @details
+ *  Each scenario is one line, its name followed by the same options the command line takes. A
+ *  line ending in a backslash continues on the next line, and lines starting with # are comments.
+ *  Every scenario is checked before the first one runs, so a mistake late in the file does not
+ *  waste the runs before it. The scenarios then run in order in this process, each with its
+ *  name printed ahead of its results. Returns 1 if any run failed.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] program
+ *  Program name, passed on as the first argument of every scenario
+ *
+ * @param[in] path
+ *  Scenario file
+ *
+ ******************************************************************************/
+static int run_scenarios(char* program, string path) {
+
+    std::ifstream file(path.c_str());
+
+    if(!file.is_open()) {
+        printf("\nCould not open %s\n\n", path.c_str());
+        return 1;
+    }
+
+    vector<string> names;
+    vector<int> lines;
+    vector<vector<string> > arguments;
+    string line;
+    string scenario;
+    int number = 0;
+    int first_line = 0;
+
+    while(std::getline(file, line)) {
+
+        number++;
+
+        if(scenario.empty()) {
+            first_line = number;
+        }
+
+        size_t text = line.find_first_not_of(" \t\r");
+
+        if(text != string::npos && line[text] == '#') {
+            continue;
+        }
+
+        if(text == string::npos) {
+
+            if(scenario.empty()) {
+                continue;
+            }
+
+            line.clear();
+
+        }
+
+        size_t end = line.find_last_not_of(" \t\r");
+        line = end == string::npos ? "" : line.substr(0, end + 1);
+
+        // A trailing backslash joins the next line on
+        if(!line.empty() && line[line.size() - 1] == '\\') {
+            scenario += line.substr(0, line.size() - 1) + " ";
+            continue;
+        }
+
+        scenario += line;
+
+        std::stringstream stream(scenario);
+        vector<string> tokens;
+        string token;
+
+        while(stream >> token) {
+            tokens.push_back(token);
+        }
+
+        scenario.clear();
+
+        if(tokens.empty()) {
+            continue;
+        }
+
+        if(tokens[0][0] == '-') {
+            printf("\nThe scenario on line %d of %s has no name\n\n", first_line, path.c_str());
+            return 1;
+        }
+
+        names.push_back(tokens[0]);
+        lines.push_back(first_line);
+        arguments.push_back(vector<string>(tokens.begin() + 1, tokens.end()));
+
+    }
+
+    if(names.empty()) {
+        printf("\nNo scenarios in %s\n\n", path.c_str());
+        return 1;
+    }
+
+    for(int pass = 0; pass < 2; pass++) {
+
+        bool check_only = pass == 0;
+        int status = 0;
+
+        for(size_t s = 0; s < names.size(); s++) {
+
+            // getopt reorders the argument pointers, so every run gets its own
+            vector<char*> argv;
+            argv.push_back(program);
+
+            for(size_t a = 0; a < arguments[s].size(); a++) {
+                argv.push_back((char*)arguments[s][a].c_str());
+            }
+
+            argv.push_back(NULL);
+
+            if(!check_only) {
+                printf("Scenario: %s\n", names[s].c_str());
+            }
+
+            int result = run_command(argv.size() - 1, &argv[0], check_only);
+
+            if(check_only && result != 0) {
+                printf("Scenario %s on line %d of %s is not valid\n\n", names[s].c_str(), lines[s], path.c_str());
+                return 1;
+            }
+
+            if(!check_only) {
+                status = result != 0 ? result : status;
+                printf("\n");
+            }
+
+        }
+
+        if(!check_only) {
+            return status;
+        }
+
+    }
+
+    return 0;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is main
+ *
+ * @details
+ *  Runs the scenarios of a scenario file when one is given, otherwise the test on the command line
+ *
+ * @note
+ * none
+ *
+ ******************************************************************************/
+int main(int argc, char* argv[]){
+	
+	// parse args
+	if(argc < 2){
+		
+        cout << argc << endl;
+		printf("Error\n" USAGE);
+		return 1;
+	}
+
+	if(argc == 2 && strncmp(argv[1], "--scenarios=", 12) == 0) {
+		return run_scenarios(argv[0], argv[1] + 12);
+	}
+
+	if(argc == 3 && strcmp(argv[1], "--scenarios") == 0) {
+		return run_scenarios(argv[0], argv[2]);
+	}
+
+	return run_command(argc, argv, false);
+
+}
@@ -16,6 +16,8 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include <unistd.h>
 #include <cmath>
 #include <iostream>
@@ -28,7 +30,10 @@
 #include "Treiber_Stack.hpp"
 #include "SGL_Queue.hpp"
 #include "SGL_Stack.hpp"
+#include "Tagged_Treiber_Stack.hpp"
+#include "Sharded_Stack.hpp"
 #include "Data_Structure_Tester.hpp"
+#include "Sweep_Runner.hpp"
 
 //***********************************************************************************
 // defined files
@@ -37,5 +42,17 @@ using std::string;
 using std::endl;
 using std::cout;
 
+#define USAGE "Usage: concurrent_structures [--name] [-t NUM_THREADS] [-i NUM_ITERATIONS] [--structure=<treiber,tagged,sharded,msQ,sglS,sglQ>] " \
+    "[--variant=<base,elimination,fc,twolock,unrolled>] [--reclaim=<ebr,qsbr,ibr>] [--stall=MS] [--batch=MAX_BATCH] [--shard=<tid,cpu>] [--scaling] " \
+    "[--workload=<phased,mixed,pair>] [--mix=INSERT_PERCENT] [--prefill=NUM_VALUES] " \
+    "[--producers=N --consumers=M] [--duration=TIME [--warmup=TIME]] [--interval=MS] [--latency] [--validate] " \
+    "[--pin=<compact,scatter,smt-first,list:CPUS>] [--counters[=HITM_RAW_EVENT]] " \
+    "[--lock=<pthread,tas,ttas,ticket>] [--barrier=<sense,pthread>] " \
+    "[--sweep [--repeat=N] [--discard=N] [--format=<csv,json>] [--output=FILE]]\n" \
+    "   or: concurrent_structures --scenarios=FILE\n" \
+    "With --sweep, --structure, --variant, --lock, --barrier and -t take comma separated lists\n" \
+    "TIME is a number followed by ms, s or m, seconds if no unit is given\n" \
+    "A scenario file has one scenario per line, a name followed by the options above, # starts a comment\n\n"
+
 
 #endif
\ No newline at end of file
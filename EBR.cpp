@@ -0,0 +1,275 @@
+/**
+ * @file EBR.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for epoch based reclamation of nodes retired by the concurrent data structures
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "EBR.hpp"
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the EBR class
+ *
+ * @details
+ *  Starts the global epoch at zero, marks every thread as outside of an operation and sizes
+ *  how often a thread attempts to advance the global epoch. Scanning the reservations costs
+ *  one load per thread, so attempts are spread out over at least that many retires.
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+EBR::EBR(int number_of_threads) {
+
+    NUM_THREADS = number_of_threads;
+    ADVANCE_FREQUENCY = number_of_threads > EBR_MIN_ADVANCE_FREQUENCY ? number_of_threads : EBR_MIN_ADVANCE_FREQUENCY;
+
+    epoch.store(0, SEQ_CST);
+    reservations = new ebr_reservation[number_of_threads];
+    threads = new ebr_thread[number_of_threads];
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        reservations[i].epoch.store(EBR_INACTIVE, SEQ_CST);
+        threads[i].advance_countdown = ADVANCE_FREQUENCY;
+        threads[i].peak_retired = 0;
+
+        for(int j = 0; j < EBR_BUCKETS; j++) {
+
+            threads[i].bucket_epoch[j] = 0;
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the EBR class
+ *
+ * @details
+ *  Frees every node that is still waiting in a retire list
+ *
+ * @note
+ *  Only call once all threads using the data structures have been joined
+ *
+ ******************************************************************************/
+EBR::~EBR() {
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        for(int j = 0; j < EBR_BUCKETS; j++) {
+
+            empty_bucket(i, j);
+
+        }
+
+    }
+
+    delete [] reservations;
+    delete [] threads;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Frees every node in one of a thread's retire buckets
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Thread that owns the bucket
+ *
+ * @param[in] bucket
+ *  Index of the bucket to empty
+ *
+ ******************************************************************************/
+void EBR::empty_bucket(int tid, int bucket) {
+
+    vector<retired_node>& retired = threads[tid].retired[bucket];
+
+    for(size_t i = 0; i < retired.size(); i++) {
+
+        retired[i].reclaim(retired[i].node, retired[i].context, tid);
+
+    }
+
+    retired.clear();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Attempts to move the global epoch forward by one
+ *
+ * @details
+ *  The epoch can only advance once every thread inside an operation has announced the current
+ *  epoch. Threads outside of an operation do not hold the epoch back.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] current_epoch
+ *  Epoch the caller observed
+ *
+ ******************************************************************************/
+void EBR::try_advance(uint64_t current_epoch) {
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        uint64_t reserved = reservations[i].epoch.load(ACQ);
+
+        if(reserved != EBR_INACTIVE && reserved != current_epoch) {
+
+            return;
+
+        }
+
+    }
+
+    epoch.compare_exchange_strong(current_epoch, current_epoch + 1, ACQREL);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Announces that a thread is about to access a data structure
+ *
+ * @details
+ *  Stores the current global epoch in the thread's reservation. The store is sequentially
+ *  consistent so no read of the data structure can be ordered before it.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void EBR::start_op(int tid) {
+
+    reservations[tid].epoch.store(epoch.load(ACQ), SEQ_CST);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Announces that a thread no longer holds references into a data structure
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void EBR::end_op(int tid) {
+
+    reservations[tid].epoch.store(EBR_INACTIVE, std::memory_order_release);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Hands an unlinked node over to be freed once no thread can still reach it
+ *
+ * @details
+ *  The node is placed in the bucket of the current epoch. A node retired in epoch e is safe to
+ *  free once the global epoch reaches e + 2, so any of the thread's buckets that far behind are
+ *  emptied first. Each node is therefore touched once when retired and once when freed, and every
+ *  ADVANCE_FREQUENCY retires the thread tries to advance the global epoch.
+ *
+ * @note
+ *  The node must already be unreachable from the data structure
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ * @param[in] node
+ *  Node to free
+ *
+ * @param[in] reclaim
+ *  Function that frees the node
+ *
+ * @param[in] context
+ *  Passed through to the reclaim function
+ *
+ ******************************************************************************/
+void EBR::retire(int tid, void* node, reclaim_function reclaim, void* context) {
+
+    ebr_thread* me = &threads[tid];
+    uint64_t current_epoch = epoch.load(ACQ);
+
+    // Emptying every bucket that is at least two epochs old
+    for(int i = 0; i < EBR_BUCKETS; i++) {
+
+        if(me->bucket_epoch[i] + 2 <= current_epoch && !me->retired[i].empty()) {
+
+            empty_bucket(tid, i);
+
+        }
+
+    }
+
+    int bucket = current_epoch % EBR_BUCKETS;
+    me->bucket_epoch[bucket] = current_epoch;
+    me->retired[bucket].push_back({node, reclaim, context});
+
+    size_t waiting = me->retired[0].size() + me->retired[1].size() + me->retired[2].size();
+    if(waiting > me->peak_retired) {
+
+        me->peak_retired = waiting;
+
+    }
+
+    me->advance_countdown += -1;
+    if(me->advance_countdown == 0) {
+
+        try_advance(current_epoch);
+        me->advance_countdown = ADVANCE_FREQUENCY;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the most retired nodes that were ever waiting to be freed
+ *
+ * @details
+ *  Sums the peak of every thread's retire lists
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+size_t EBR::peak_unreclaimed() {
+
+    size_t peak = 0;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        peak += threads[i].peak_retired;
+
+    }
+
+    return peak;
+
+}
@@ -0,0 +1,76 @@
+/*
+ * EBR.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef EBR_HPP
+#define EBR_HPP
+
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include "Reclamation.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::atomic;
+using std::vector;
+
+#define ACQREL std::memory_order_acq_rel
+#define ACQ std::memory_order_acquire
+#define SEQ_CST std::memory_order_seq_cst
+
+#define EBR_BUCKETS 3
+#define EBR_INACTIVE UINT64_MAX
+#define EBR_MIN_ADVANCE_FREQUENCY 64
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// Each thread's announced epoch sits on its own cache line
+struct alignas(CACHE_LINE_SIZE) ebr_reservation {
+
+    atomic<uint64_t> epoch;
+
+};
+
+// Per thread retire lists, one bucket per epoch modulo EBR_BUCKETS
+struct alignas(CACHE_LINE_SIZE) ebr_thread {
+
+    vector<retired_node> retired[EBR_BUCKETS];
+    uint64_t bucket_epoch[EBR_BUCKETS];
+    int advance_countdown;
+    size_t peak_retired;
+
+};
+
+class EBR {
+
+    private:
+    alignas(CACHE_LINE_SIZE) atomic<uint64_t> epoch;
+    ebr_reservation* reservations;
+    ebr_thread* threads;
+    int NUM_THREADS;
+    int ADVANCE_FREQUENCY;
+    void try_advance(uint64_t current_epoch);
+    void empty_bucket(int tid, int bucket);
+
+    public:
+    EBR(int number_of_threads);
+    ~EBR();
+    void start_op(int tid);
+    void end_op(int tid);
+    void retire(int tid, void* node, reclaim_function reclaim, void* context);
+    size_t peak_unreclaimed();
+    template<typename T> void retire(int tid, T* node) { retire(tid, node, &delete_node<T>, NULL); }
+
+};
+
+#endif
@@ -0,0 +1,666 @@
+/**
+ * @file Elimination_Array.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for the adaptive elimination layer shared by the stacks and the queue
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "Elimination_Array.hpp"
+
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  Tells the core the caller is spinning
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static inline void cpu_relax() {
+
+    #if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+    #elif defined(__aarch64__)
+    asm volatile("yield");
+    #endif
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the monotonic wall clock time in nanoseconds
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static inline uint64_t now_ns() {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Packs a slot state and a payload into a slot word
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] state
+ *  State stored in the high 2 bits
+ *
+ * @param[in] payload
+ *  Node pointer or thread id stored in the low 48 bits
+ *
+ ******************************************************************************/
+static inline uint64_t pack(elimination_state state, uint64_t payload) {
+
+    return ((uint64_t)state << ELIM_STATE_SHIFT) | (payload & ELIM_PAYLOAD_MASK);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the state held in a slot word
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] word
+ *  Slot word
+ *
+ ******************************************************************************/
+static inline elimination_state unpack_state(uint64_t word) {
+
+    return (elimination_state)(word >> ELIM_STATE_SHIFT);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the node pointer held in a slot word
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] word
+ *  Slot word
+ *
+ ******************************************************************************/
+static inline void* unpack_node(uint64_t word) {
+
+    return (void*)(word & ELIM_PAYLOAD_MASK);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Measures how many relaxed spins fit in the wait for a partner
+ *
+ * @details
+ *  Run once per process, so repeated tests all wait the same number of spins and none of
+ *  them pays for the calibration loop
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+static uint64_t calibrate_wait_spins() {
+
+    uint64_t start = now_ns();
+
+    for(int i = 0; i < ELIM_CALIBRATION_SPINS; i++) {
+
+        cpu_relax();
+
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    if(elapsed == 0) {
+
+        elapsed = 1;
+
+    }
+
+    uint64_t spins = (uint64_t)ELIM_CALIBRATION_SPINS * ELIM_WAIT_NS / elapsed;
+
+    return spins == 0 ? 1 : spins;
+
+}
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Elimination_Array class
+ *
+ * @details
+ *  Empties every slot, seeds each thread's random number generator and starts every thread
+ *  on a window of one slot. The array never grows past half the threads, since a slot needs
+ *  two threads to be useful. The wait for a partner is calibrated once per process into a spin
+ *  count so the waiting loop never has to read the clock.
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Elimination_Array::Elimination_Array(int number_of_threads) {
+
+    NUM_THREADS = number_of_threads;
+    MAX_WIDTH = number_of_threads / 2;
+
+    if(MAX_WIDTH < 1) {
+
+        MAX_WIDTH = 1;
+
+    }
+
+    if(MAX_WIDTH > ELIM_MAX_WIDTH) {
+
+        MAX_WIDTH = ELIM_MAX_WIDTH;
+
+    }
+
+    for(int i = 0; i < ELIM_MAX_WIDTH; i++) {
+
+        slots[i].word.store(pack(slot_empty, 0), RELAXED);
+
+    }
+
+    exchangers = new elimination_exchanger[number_of_threads];
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        // xorshift must never be seeded with zero
+        exchangers[i].rng = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1);
+        exchangers[i].width = 1;
+        exchangers[i].adapt = 0;
+        exchangers[i].attempts = 0;
+        exchangers[i].hits = 0;
+
+    }
+
+    // Every array in the process shares one calibration
+    static const uint64_t calibrated_spins = calibrate_wait_spins();
+    WAIT_SPINS = calibrated_spins;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the Elimination_Array class
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Elimination_Array::~Elimination_Array() {
+
+    delete [] exchangers;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Steps a thread's xorshift random number generator
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] me
+ *  Calling thread's exchanger record
+ *
+ ******************************************************************************/
+uint64_t Elimination_Array::next_random(elimination_exchanger* me) {
+
+    uint64_t x = me->rng;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    me->rng = x;
+
+    return x;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Records that an attempt found its slot busy
+ *
+ * @details
+ *  Too many threads are landing on too few slots, so the window doubles after
+ *  ELIM_ADAPT_LIMIT collisions
+ *
+ * @note
+ *  none
+ *
+ * @param[in] me
+ *  Calling thread's exchanger record
+ *
+ ******************************************************************************/
+void Elimination_Array::collided(elimination_exchanger* me) {
+
+    me->adapt++;
+
+    if(me->adapt >= ELIM_ADAPT_LIMIT) {
+
+        me->width = me->width * 2 < MAX_WIDTH ? me->width * 2 : MAX_WIDTH;
+        me->adapt = 0;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Records that an attempt waited without a partner showing up
+ *
+ * @details
+ *  Threads are spread over too many slots to meet, so the window halves after
+ *  ELIM_ADAPT_LIMIT timeouts
+ *
+ * @note
+ *  none
+ *
+ * @param[in] me
+ *  Calling thread's exchanger record
+ *
+ ******************************************************************************/
+void Elimination_Array::timed_out(elimination_exchanger* me) {
+
+    me->adapt--;
+
+    if(me->adapt <= -ELIM_ADAPT_LIMIT) {
+
+        me->width = me->width / 2 > 1 ? me->width / 2 : 1;
+        me->adapt = 0;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Spins until a slot no longer holds the caller's word or the wait runs out
+ *
+ * @details
+ *  Only the owner of a waiting word can put it in a slot, so once the slot changes a
+ *  partner has matched the caller
+ *
+ * @note
+ *  Returns the caller's word if no partner showed up
+ *
+ * @param[in] slot
+ *  Slot the caller is waiting in
+ *
+ * @param[in] mine
+ *  Word the caller placed in the slot
+ *
+ ******************************************************************************/
+uint64_t Elimination_Array::wait_for_partner(elimination_slot* slot, uint64_t mine) {
+
+    for(uint64_t i = 0; i < WAIT_SPINS; i++) {
+
+        uint64_t current = slot->word.load(ACQ);
+
+        if(current != mine) {
+
+            return current;
+
+        }
+
+        cpu_relax();
+
+    }
+
+    return mine;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Tries to hand a pushed node straight to a concurrent pop
+ *
+ * @details
+ *  A pop already waiting in the slot is given the node directly. An empty slot is claimed
+ *  and the push waits for a pop to take the node, withdrawing it again if none does.
+ *
+ * @note
+ *  Returns true if the node was taken by a pop, the caller no longer owns it
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ * @param[in] node
+ *  Node to hand over
+ *
+ ******************************************************************************/
+bool Elimination_Array::exchange_push(int tid, void* node) {
+
+    elimination_exchanger* me = &exchangers[tid];
+    elimination_slot* slot = &slots[next_random(me) % me->width];
+    me->attempts++;
+
+    uint64_t current = slot->word.load(ACQ);
+
+    switch(unpack_state(current)) {
+
+        case(pop_waiting):{
+
+            if(slot->word.compare_exchange_strong(current, pack(pop_delivered, (uint64_t)node), ACQREL)) {
+
+                me->hits++;
+                return true;
+
+            }
+
+            collided(me);
+            return false;
+
+        }
+
+        case(slot_empty):{
+
+            uint64_t mine = pack(push_waiting, (uint64_t)node);
+
+            if(!slot->word.compare_exchange_strong(current, mine, ACQREL)) {
+
+                collided(me);
+                return false;
+
+            }
+
+            // A pop takes the node by emptying the slot, withdrawing only fails if that happened
+            if(wait_for_partner(slot, mine) == mine && slot->word.compare_exchange_strong(mine, pack(slot_empty, 0), ACQREL)) {
+
+                timed_out(me);
+                return false;
+
+            }
+
+            me->hits++;
+            return true;
+
+        }
+
+        default:{
+
+            collided(me);
+            return false;
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Tries to take a node straight from a concurrent push
+ *
+ * @details
+ *  A push already waiting in the slot has its node taken. An empty slot is claimed and the
+ *  pop waits for a push to deliver a node, withdrawing again if none does.
+ *
+ * @note
+ *  Returns NULL if no push was matched
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void* Elimination_Array::exchange_pop(int tid) {
+
+    elimination_exchanger* me = &exchangers[tid];
+    elimination_slot* slot = &slots[next_random(me) % me->width];
+    me->attempts++;
+
+    uint64_t current = slot->word.load(ACQ);
+
+    switch(unpack_state(current)) {
+
+        case(push_waiting):{
+
+            if(slot->word.compare_exchange_strong(current, pack(slot_empty, 0), ACQREL)) {
+
+                me->hits++;
+                return unpack_node(current);
+
+            }
+
+            collided(me);
+            return NULL;
+
+        }
+
+        case(slot_empty):{
+
+            uint64_t mine = pack(pop_waiting, (uint64_t)tid);
+
+            if(!slot->word.compare_exchange_strong(current, mine, ACQREL)) {
+
+                collided(me);
+                return NULL;
+
+            }
+
+            uint64_t delivered = wait_for_partner(slot, mine);
+
+            if(delivered == mine) {
+
+                if(slot->word.compare_exchange_strong(mine, pack(slot_empty, 0), ACQREL)) {
+
+                    timed_out(me);
+                    return NULL;
+
+                }
+
+                // A push delivered after the wait ran out, mine now holds the delivered word
+                delivered = mine;
+
+            }
+
+            // Only the waiting pop can empty a delivered slot
+            slot->word.store(pack(slot_empty, 0), RELEASE);
+            me->hits++;
+
+            return unpack_node(delivered);
+
+        }
+
+        default:{
+
+            collided(me);
+            return NULL;
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Offers a node to a concurrent take without ever handing it to a waiting pop
+ *
+ * @details
+ *  Claims an empty slot and waits for a take to remove the node, withdrawing it again if
+ *  none does
+ *
+ * @note
+ *  Returns true if the node was taken, the caller no longer owns it
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ * @param[in] node
+ *  Node to hand over
+ *
+ ******************************************************************************/
+bool Elimination_Array::offer(int tid, void* node) {
+
+    elimination_exchanger* me = &exchangers[tid];
+    elimination_slot* slot = &slots[next_random(me) % me->width];
+    me->attempts++;
+
+    uint64_t current = slot->word.load(ACQ);
+    uint64_t mine = pack(push_waiting, (uint64_t)node);
+
+    if(unpack_state(current) != slot_empty || !slot->word.compare_exchange_strong(current, mine, ACQREL)) {
+
+        collided(me);
+        return false;
+
+    }
+
+    if(wait_for_partner(slot, mine) == mine && slot->word.compare_exchange_strong(mine, pack(slot_empty, 0), ACQREL)) {
+
+        timed_out(me);
+        return false;
+
+    }
+
+    me->hits++;
+    return true;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Takes an offered node if the caller's condition holds while the offer is pending
+ *
+ * @details
+ *  Never waits. The check runs after the offer was seen in its slot and before the offer is
+ *  removed, so the condition held at a point where both operations were in progress.
+ *
+ * @note
+ *  Returns NULL if no offer was taken
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ * @param[in] check
+ *  Condition that must hold for the offer to be taken
+ *
+ * @param[in] context
+ *  Passed through to the check
+ *
+ ******************************************************************************/
+void* Elimination_Array::take(int tid, elimination_check check, void* context) {
+
+    elimination_exchanger* me = &exchangers[tid];
+    elimination_slot* slot = &slots[next_random(me) % me->width];
+    me->attempts++;
+
+    uint64_t current = slot->word.load(ACQ);
+
+    if(unpack_state(current) != push_waiting) {
+
+        timed_out(me);
+        return NULL;
+
+    }
+
+    if(!check(context)) {
+
+        return NULL;
+
+    }
+
+    if(!slot->word.compare_exchange_strong(current, pack(slot_empty, 0), ACQREL)) {
+
+        collided(me);
+        return NULL;
+
+    }
+
+    me->hits++;
+
+    return unpack_node(current);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns how many operations completed through elimination
+ *
+ * @details
+ *  Both the push and the pop of an eliminated pair are counted
+ *
+ * @note
+ *  Only call once all threads using the array have been joined
+ *
+ ******************************************************************************/
+uint64_t Elimination_Array::hits() {
+
+    uint64_t total = 0;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        total += exchangers[i].hits;
+
+    }
+
+    return total;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns how many elimination attempts were made
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  Only call once all threads using the array have been joined
+ *
+ ******************************************************************************/
+uint64_t Elimination_Array::attempts() {
+
+    uint64_t total = 0;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        total += exchangers[i].attempts;
+
+    }
+
+    return total;
+
+}
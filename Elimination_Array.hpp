@@ -0,0 +1,118 @@
+/*
+ * Elimination_Array.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef ELIMINATION_ARRAY_HPP
+#define ELIMINATION_ARRAY_HPP
+
+#include <atomic>
+#include <stdint.h>
+#include <time.h>
+#include "Reclamation.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::atomic;
+
+#define ACQREL std::memory_order_acq_rel
+#define ACQ std::memory_order_acquire
+#define RELEASE std::memory_order_release
+#define RELAXED std::memory_order_relaxed
+
+#define ELIM_MAX_WIDTH 16
+#define ELIM_ADAPT_LIMIT 8
+#define ELIM_WAIT_NS 2000
+#define ELIM_CALIBRATION_SPINS 100000
+
+// A slot word holds the slot state in the high 2 bits and a 48 bit payload in the low bits
+#define ELIM_STATE_SHIFT 62
+#define ELIM_PAYLOAD_MASK ((1ULL << 48) - 1)
+
+static_assert(sizeof(void*) == 8, "Elimination slots need 64 bit pointers");
+
+// Called by take before it removes an offer, the offer is only taken if it returns true
+typedef bool (*elimination_check)(void* context);
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+enum elimination_state {
+
+    slot_empty,
+    push_waiting,
+    pop_waiting,
+    pop_delivered
+
+};
+
+// One exchange point, each slot owns its cache line
+struct alignas(CACHE_LINE_SIZE) elimination_slot {
+
+    atomic<uint64_t> word;
+
+};
+
+// Per thread exchanger record, reused by every elimination attempt the thread makes
+struct alignas(CACHE_LINE_SIZE) elimination_exchanger {
+
+    uint64_t rng;
+    int width;
+    int adapt;
+    uint64_t attempts;
+    uint64_t hits;
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  Elimination layer that lets a push and a pop cancel each other out
+ *
+ * @details
+ *  A push offers its node in a random slot and a pop waiting in a slot receives a node from a
+ *  push, so the pair completes without touching the stack. Slots are single words, a waiting
+ *  operation withdraws by swapping its own word back to empty and learns that it was matched
+ *  when that swap fails. Each thread picks slots out of its own window of the array. The window
+ *  doubles after repeated collisions on busy slots and halves after repeated waits that found
+ *  no partner.
+ *
+ *  Structures that can only eliminate under a condition, such as a queue that must be empty,
+ *  use offer and take instead. Offers only wait for a taker and take checks the condition
+ *  while the offer is still in its slot.
+ *
+ * @note
+ *  Pushed nodes must not be NULL
+ *
+ ******************************************************************************/
+class Elimination_Array {
+
+    private:
+    elimination_slot slots[ELIM_MAX_WIDTH];
+    elimination_exchanger* exchangers;
+    int NUM_THREADS;
+    int MAX_WIDTH;
+    uint64_t WAIT_SPINS;
+    uint64_t next_random(elimination_exchanger* me);
+    void collided(elimination_exchanger* me);
+    void timed_out(elimination_exchanger* me);
+    uint64_t wait_for_partner(elimination_slot* slot, uint64_t mine);
+
+    public:
+    Elimination_Array(int number_of_threads);
+    ~Elimination_Array();
+    bool exchange_push(int tid, void* node);
+    void* exchange_pop(int tid);
+    bool offer(int tid, void* node);
+    void* take(int tid, elimination_check check, void* context);
+    uint64_t hits();
+    uint64_t attempts();
+
+};
+
+#endif
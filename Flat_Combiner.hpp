@@ -0,0 +1,293 @@
+/*
+ * Flat_Combiner.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef FLAT_COMBINER_HPP
+#define FLAT_COMBINER_HPP
+
+#include <atomic>
+#include <stdint.h>
+#include <sched.h>
+#include "Locks.hpp"
+#include "Reclamation.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::atomic;
+
+#define ACQREL std::memory_order_acq_rel
+#define ACQ std::memory_order_acquire
+#define RELEASE std::memory_order_release
+#define RELAXED std::memory_order_relaxed
+
+#define FC_COMBINING_PASSES 3
+#define FC_CLEANUP_FREQUENCY 64
+#define FC_AGE_LIMIT 1024
+#define FC_WAIT_SPINS 256
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// A thread's publication record, the request and its result share the record
+template<typename Op>
+struct alignas(CACHE_LINE_SIZE) fc_record {
+
+    Op op;
+    atomic<bool> pending;
+    atomic<bool> active;
+    uint64_t age;
+    atomic<fc_record<Op>*> next;
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  Turns a sequential data structure into a flat combined concurrent one
+ *
+ * @details
+ *  Each thread owns one publication record. A thread writes its request into the record and
+ *  links the record into the publication list if it is not already there. Whichever thread
+ *  gets the lock becomes the combiner. It walks the list and applies every pending request
+ *  to the sequential structure, writing each result back into its record. The walk repeats
+ *  up to FC_COMBINING_PASSES times while it keeps finding requests. Every other thread spins
+ *  on its own record until the request is served or the lock looks free. A thread that finds
+ *  the lock free right away combines without publishing, its own request joins the first pass.
+ *
+ *  The combiner stamps each record it serves with the pass number. Every FC_CLEANUP_FREQUENCY
+ *  combines it unlinks records that have been idle for FC_AGE_LIMIT passes, so threads that
+ *  stopped using the structure no longer cost the combiner anything. An unlinked thread
+ *  links its record again on its next request.
+ *
+ *  Seq must provide an operation type and apply_batch(operation** ops, int count, int tid),
+ *  which performs every operation of one pass and leaves each result in its operation. Since
+ *  the whole pass is concurrent, apply_batch may perform the operations in any order or match
+ *  them against each other. apply_batch only ever runs while the lock is held.
+ *
+ * @note
+ *  The first record in the list is never unlinked, since threads link new records there
+ *
+ ******************************************************************************/
+template<typename Seq>
+class Flat_Combiner {
+
+    typedef typename Seq::operation operation;
+
+    private:
+    Seq* structure;
+    fc_record<operation>* records;
+    fc_record<operation>** batch_records;
+    operation** batch;
+    atomic<fc_record<operation>*> publication_list;
+    uint64_t combining_pass;
+    uint64_t combines;
+    int NUM_THREADS;
+
+    // Links a record at the head of the publication list
+    void publish(fc_record<operation>* record) {
+
+        record->active.store(true, RELAXED);
+        fc_record<operation>* head = publication_list.load(ACQ);
+
+        do {
+
+            record->next.store(head, RELAXED);
+
+        } while(!publication_list.compare_exchange_weak(head, record, ACQREL, ACQ));
+
+    }
+
+    // Unlinks records that have not made a request in FC_AGE_LIMIT passes, called with the lock held
+    void age_out() {
+
+        fc_record<operation>* previous = publication_list.load(ACQ);
+
+        if(previous == NULL) {
+
+            return;
+
+        }
+
+        fc_record<operation>* current = previous->next.load(RELAXED);
+
+        while(current != NULL) {
+
+            fc_record<operation>* next = current->next.load(RELAXED);
+
+            if(!current->pending.load(ACQ) && combining_pass - current->age > FC_AGE_LIMIT) {
+
+                previous->next.store(next, RELAXED);
+
+                // The owner may relink the record as soon as it sees it inactive
+                current->active.store(false, RELEASE);
+
+            }
+
+            else {
+
+                previous = current;
+
+            }
+
+            current = next;
+
+        }
+
+    }
+
+    // Serves every pending request in the publication list, called with the lock held. The combiner's
+    // own operation, if it has one, joins the first pass.
+    void combine(operation* own, int tid) {
+
+        for(int pass = 0; pass < FC_COMBINING_PASSES; pass++) {
+
+            combining_pass++;
+            int count = 0;
+            int served = 0;
+
+            if(own != NULL) {
+
+                batch[count] = own;
+                count++;
+                own = NULL;
+
+            }
+
+            fc_record<operation>* record = publication_list.load(ACQ);
+
+            while(record != NULL) {
+
+                if(record->pending.load(ACQ)) {
+
+                    batch_records[served] = record;
+                    batch[count] = &record->op;
+                    served++;
+                    count++;
+
+                }
+
+                record = record->next.load(RELAXED);
+
+            }
+
+            if(count > 0) {
+
+                structure->apply_batch(batch, count, tid);
+
+            }
+
+            for(int i = 0; i < served; i++) {
+
+                batch_records[i]->age = combining_pass;
+                batch_records[i]->pending.store(false, RELEASE);
+
+            }
+
+            if(served == 0) {
+
+                break;
+
+            }
+
+        }
+
+        combines++;
+
+        if(combines % FC_CLEANUP_FREQUENCY == 0) {
+
+            age_out();
+
+        }
+
+    }
+
+    public:
+    Flat_Combiner(Seq* sequential_structure, int number_of_threads) {
+
+        structure = sequential_structure;
+        NUM_THREADS = number_of_threads;
+        combining_pass = 0;
+        combines = 0;
+        publication_list.store(NULL, RELAXED);
+        records = new fc_record<operation>[number_of_threads];
+        batch_records = new fc_record<operation>*[number_of_threads];
+        batch = new operation*[number_of_threads + 1];
+
+        for(int i = 0; i < number_of_threads; i++) {
+
+            records[i].pending.store(false, RELAXED);
+            records[i].active.store(false, RELAXED);
+            records[i].age = 0;
+            records[i].next.store(NULL, RELAXED);
+
+        }
+
+    }
+
+    ~Flat_Combiner() {
+
+        delete [] records;
+        delete [] batch_records;
+        delete [] batch;
+
+    }
+
+    // Has op applied to the structure by whichever thread is combining, op holds the result on return
+    void apply(operation& op, Locks* lock, int tid) {
+
+        // Uncontended, the thread combines without publishing its own request
+        if(lock->try_acquire() == 0) {
+
+            combine(&op, tid);
+            lock->release();
+
+            return;
+
+        }
+
+        fc_record<operation>* record = &records[tid];
+        record->op = op;
+        record->pending.store(true, RELEASE);
+
+        while(true) {
+
+            if(!record->active.load(ACQ)) {
+
+                publish(record);
+
+            }
+
+            if(lock->try_acquire() == 0) {
+
+                combine(NULL, tid);
+                lock->release();
+
+            }
+
+            for(int i = 0; i < FC_WAIT_SPINS && record->pending.load(ACQ) && record->active.load(ACQ); i++) {}
+
+            if(!record->pending.load(ACQ)) {
+
+                break;
+
+            }
+
+            // The combiner may be descheduled, give it the core rather than spinning on
+            sched_yield();
+
+        }
+
+        op = record->op;
+
+    }
+
+};
+
+#endif
@@ -0,0 +1,419 @@
+/**
+ * @file History_Checker.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for checking the operation histories of a test
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "History_Checker.hpp"
+
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+static bool invoked_first(const history_event& a, const history_event& b) {
+
+    return a.invoked < b.invoked;
+
+}
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the History_Checker class
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  The histories must outlive the checker
+ *
+ * @param[in] thread_histories
+ *  One history per thread, each in the order the thread completed its operations
+ *
+ * @param[in] threads
+ *  Number of threads, which the inserted values were numbered by
+ *
+ * @param[in] removals
+ *  Order the structure removes values in
+ *
+ ******************************************************************************/
+History_Checker::History_Checker(vector<history_event>* thread_histories, int threads, removal_order removals) {
+
+    histories = thread_histories;
+    number_of_threads = threads;
+    order = removals;
+    states = 0;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Runs every check that applies to the structure
+ *
+ * @details
+ *  Conservation always runs, the FIFO check only for queues and the linearizability search
+ *  for stacks and queues whose history is short enough
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+validation_report History_Checker::check() {
+
+    validation_report report;
+    report.inserts = 0;
+    report.removes = 0;
+    report.empty_removes = 0;
+    report.lost = 0;
+    report.duplicated = 0;
+    report.unknown = 0;
+    report.fifo_violations = 0;
+    report.linearizability = not_checked;
+
+    check_conservation(&report);
+
+    if(order == fifo_order) {
+        check_fifo(&report);
+    }
+
+    if(order == unordered) {
+        return report;
+    }
+
+    events.clear();
+
+    for(int i = 0; i < number_of_threads; i++) {
+        events.insert(events.end(), histories[i].begin(), histories[i].end());
+    }
+
+    if(events.size() > LINEARIZABILITY_MAX_EVENTS) {
+        report.linearizability = history_too_long;
+        return report;
+    }
+
+    std::stable_sort(events.begin(), events.end(), invoked_first);
+    linearized.assign(events.size(), false);
+    contents.clear();
+    visited.clear();
+    states = 0;
+
+    report.linearizability = search(events.size());
+
+    visited.clear();
+
+    return report;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns whether every check that ran passed
+ *
+ * @details
+ *  A linearizability search that was skipped or gave up does not fail the validation
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+bool History_Checker::passed(const validation_report& report) {
+
+    return report.lost == 0 && report.duplicated == 0 && report.unknown == 0 && report.fifo_violations == 0 &&
+        report.linearizability != non_linearizable_history;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Checks that the values removed are exactly the values inserted
+ *
+ * @details
+ *  A value removed more than once is duplicated, a value never removed is lost and a value
+ *  never inserted is unknown
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+void History_Checker::check_conservation(validation_report* report) {
+
+    std::unordered_map<int, int> outstanding;
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        for(size_t e = 0; e < histories[i].size(); e++) {
+
+            if(histories[i][e].insert) {
+                outstanding[histories[i][e].value]++;
+                report->inserts++;
+            }
+
+        }
+
+    }
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        for(size_t e = 0; e < histories[i].size(); e++) {
+
+            const history_event& event = histories[i][e];
+
+            if(event.insert) {
+                continue;
+            }
+
+            if(event.value == -1) {
+                report->empty_removes++;
+                continue;
+            }
+
+            report->removes++;
+
+            std::unordered_map<int, int>::iterator found = outstanding.find(event.value);
+
+            if(found == outstanding.end()) {
+                report->unknown++;
+            }
+            else if(found->second == 0) {
+                report->duplicated++;
+            }
+            else {
+                found->second--;
+            }
+
+        }
+
+    }
+
+    for(std::unordered_map<int, int>::iterator it = outstanding.begin(); it != outstanding.end(); it++) {
+        report->lost += it->second;
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Checks that each thread removes every other thread's values in the order they were inserted
+ *
+ * @details
+ *  A thread's inserts and removes are each in program order, so a thread removing a later value
+ *  of some inserting thread before an earlier one sees a queue that is not first in first out
+ *
+ * @note
+ *  Only meaningful for queues
+ *
+ ******************************************************************************/
+void History_Checker::check_fifo(validation_report* report) {
+
+    vector<long long> last(number_of_threads);
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        std::fill(last.begin(), last.end(), -1);
+
+        for(size_t e = 0; e < histories[i].size(); e++) {
+
+            const history_event& event = histories[i][e];
+
+            if(event.insert || event.value < 0) {
+                continue;
+            }
+
+            int inserter = event.value % number_of_threads;
+            long long sequence = event.value / number_of_threads;
+
+            if(sequence < last[inserter]) {
+                report->fifo_violations++;
+            }
+
+            last[inserter] = sequence > last[inserter] ? sequence : last[inserter];
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Applies an operation to the sequential structure
+ *
+ * @details
+ *  Returns false, leaving the contents alone, if the sequential stack or queue could not have
+ *  given the operation's result
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+bool History_Checker::apply(const history_event& event) {
+
+    if(event.insert) {
+        contents.push_back(event.value);
+        return true;
+    }
+
+    if(event.value == -1) {
+        return contents.empty();
+    }
+
+    if(contents.empty()) {
+        return false;
+    }
+
+    if(order == lifo_order) {
+
+        if(contents.back() != event.value) {
+            return false;
+        }
+
+        contents.pop_back();
+
+    }
+    else {
+
+        if(contents.front() != event.value) {
+            return false;
+        }
+
+        contents.pop_front();
+
+    }
+
+    return true;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Takes an applied operation back out of the sequential structure
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  Only call on the operation applied last
+ *
+ ******************************************************************************/
+void History_Checker::undo(const history_event& event) {
+
+    if(event.insert) {
+        contents.pop_back();
+    }
+    else if(event.value == -1) {
+        return;
+    }
+    else if(order == lifo_order) {
+        contents.push_back(event.value);
+    }
+    else {
+        contents.push_front(event.value);
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the search state as a key for the visited set
+ *
+ * @details
+ *  The linearized operations as a bit set followed by the contents of the sequential structure
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+string History_Checker::state_key() {
+
+    string key((linearized.size() + 7) / 8, '\0');
+
+    for(size_t i = 0; i < linearized.size(); i++) {
+
+        if(linearized[i]) {
+            key[i / 8] |= (char)(1 << (i % 8));
+        }
+
+    }
+
+    for(size_t i = 0; i < contents.size(); i++) {
+        key.append((const char*)&contents[i], sizeof(int));
+    }
+
+    return key;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Searches for a linearization of the operations not yet linearized
+ *
+ * @details
+ *  Operations are tried in invocation order. One that was invoked after some remaining operation
+ *  responded can not go next, and neither can any invoked after it, so the loop stops there.
+ *
+ * @note
+ *  Recursion is one level per operation, the history length limit bounds it
+ *
+ * @param[in] remaining
+ *  Operations left to linearize
+ *
+ ******************************************************************************/
+linearizability_result History_Checker::search(size_t remaining) {
+
+    if(remaining == 0) {
+        return linearizable_history;
+    }
+
+    if(++states > LINEARIZABILITY_MAX_STATES) {
+        return search_gave_up;
+    }
+
+    if(!visited.insert(state_key()).second) {
+        return non_linearizable_history;
+    }
+
+    uint64_t earliest_response = UINT64_MAX;
+
+    for(size_t i = 0; i < events.size(); i++) {
+
+        if(!linearized[i] && events[i].responded < earliest_response) {
+            earliest_response = events[i].responded;
+        }
+
+    }
+
+    for(size_t i = 0; i < events.size(); i++) {
+
+        if(linearized[i]) {
+            continue;
+        }
+
+        if(events[i].invoked > earliest_response) {
+            break;
+        }
+
+        if(!apply(events[i])) {
+            continue;
+        }
+
+        linearized[i] = true;
+        linearizability_result result = search(remaining - 1);
+        linearized[i] = false;
+        undo(events[i]);
+
+        if(result != non_linearizable_history) {
+            return result;
+        }
+
+    }
+
+    return non_linearizable_history;
+
+}
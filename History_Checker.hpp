@@ -0,0 +1,125 @@
+/*
+ * History_Checker.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef HISTORY_CHECKER_HPP
+#define HISTORY_CHECKER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::string;
+using std::vector;
+
+// Histories with more operations than this skip the linearizability search
+#define LINEARIZABILITY_MAX_EVENTS 512
+
+// States the linearizability search may visit before it gives up
+#define LINEARIZABILITY_MAX_STATES 200000
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// One completed operation. The value of a remove is -1 if it found the structure empty.
+struct history_event {
+
+    bool insert;
+    int value;
+    uint64_t invoked;
+    uint64_t responded;
+
+};
+
+// Order the structure promises to remove values in
+enum removal_order {
+
+    lifo_order,
+    fifo_order,
+    unordered
+
+};
+
+enum linearizability_result {
+
+    linearizable_history,
+    non_linearizable_history,
+    history_too_long,
+    search_gave_up,
+    not_checked
+
+};
+
+// What the checks found
+struct validation_report {
+
+    uint64_t inserts;
+    uint64_t removes;
+    uint64_t empty_removes;
+    uint64_t lost;
+    uint64_t duplicated;
+    uint64_t unknown;
+    uint64_t fifo_violations;
+    linearizability_result linearizability;
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  Checks the operation histories of a test for lost, duplicated and misordered values
+ *
+ * @details
+ *  Every thread records the operations it completed, and every inserted value is unique: thread
+ *  tid inserts tid, tid + threads, tid + 2 * threads and so on, so a value names the thread that
+ *  inserted it and its place in that thread's order. The structure must be empty when the history
+ *  ends. Conservation checks that every inserted value was removed exactly once and nothing else
+ *  was removed. For queues, a thread must remove any one thread's values in the order they were
+ *  inserted. When the history is short enough it is also searched for a linearization in the
+ *  manner of Wing and Gong: an operation may go next if it was invoked before every remaining
+ *  operation responded and the sequential stack or queue allows it, with already visited
+ *  combinations of linearized operations and contents remembered so they are not searched twice.
+ *
+ * @note
+ *  Unordered structures only get the conservation check
+ *
+ ******************************************************************************/
+class History_Checker {
+
+    private:
+    vector<history_event>* histories;
+    int number_of_threads;
+    removal_order order;
+    vector<history_event> events;
+    vector<bool> linearized;
+    std::deque<int> contents;
+    std::unordered_set<string> visited;
+    uint64_t states;
+    void check_conservation(validation_report* report);
+    void check_fifo(validation_report* report);
+    bool apply(const history_event& event);
+    void undo(const history_event& event);
+    string state_key();
+    linearizability_result search(size_t remaining);
+
+    public:
+    History_Checker(vector<history_event>* thread_histories, int threads, removal_order removals);
+    validation_report check();
+    static bool passed(const validation_report& report);
+
+};
+
+#endif
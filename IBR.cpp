@@ -0,0 +1,318 @@
+/**
+ * @file IBR.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for interval based reclamation of retired nodes
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "IBR.hpp"
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the IBR class
+ *
+ * @details
+ *  Starts the global era at zero and marks every thread as outside of an operation. A retire
+ *  list scan reads every reservation, so scans are spread out over at least that many retires.
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+IBR::IBR(int number_of_threads) {
+
+    NUM_THREADS = number_of_threads;
+    SCAN_FREQUENCY = number_of_threads > IBR_MIN_SCAN_FREQUENCY ? number_of_threads : IBR_MIN_SCAN_FREQUENCY;
+
+    era.store(0, SEQ_CST);
+    reservations = new ibr_reservation[number_of_threads];
+    threads = new ibr_thread[number_of_threads];
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        reservations[i].lower.store(IBR_INACTIVE, SEQ_CST);
+        reservations[i].upper.store(IBR_INACTIVE, SEQ_CST);
+        threads[i].era_countdown = IBR_ERA_FREQUENCY;
+        threads[i].scan_threshold = SCAN_FREQUENCY;
+        threads[i].peak_retired = 0;
+        threads[i].lower_snapshot.resize(number_of_threads);
+        threads[i].upper_snapshot.resize(number_of_threads);
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the IBR class
+ *
+ * @details
+ *  Frees every node that is still waiting in a retire list
+ *
+ * @note
+ *  Only call once all threads using the data structures have been joined
+ *
+ ******************************************************************************/
+IBR::~IBR() {
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        vector<ibr_retired_node>& retired = threads[i].retired;
+
+        for(size_t j = 0; j < retired.size(); j++) {
+
+            retired[j].retired.reclaim(retired[j].retired.node, retired[j].retired.context, i);
+
+        }
+
+    }
+
+    delete [] reservations;
+    delete [] threads;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Announces that a thread is about to access a data structure
+ *
+ * @details
+ *  Reserves the interval holding only the current era. protect() widens it as the operation reads
+ *  pointers in later eras.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void IBR::start_op(int tid) {
+
+    uint64_t current = era.load(ACQ);
+    reservations[tid].lower.store(current, SEQ_CST);
+    reservations[tid].upper.store(current, SEQ_CST);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Announces that a thread no longer holds references into a data structure
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void IBR::end_op(int tid) {
+
+    reservations[tid].lower.store(IBR_INACTIVE, RELEASE);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Counts an allocation or retire towards advancing the global era
+ *
+ * @details
+ *  Every IBR_ERA_FREQUENCY allocations or retires by a thread the global era is advanced. Allocations
+ *  moving the era means a thread that stalls inside an operation only holds back nodes allocated
+ *  before it stalled. Retires moving the era means running threads stop overlapping a node's
+ *  lifetime soon after it is retired, even when nothing is being allocated.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void IBR::count_era_event(int tid) {
+
+    ibr_thread* me = &threads[tid];
+
+    me->era_countdown += -1;
+    if(me->era_countdown == 0) {
+
+        era.fetch_add(1, ACQREL);
+        me->era_countdown = IBR_ERA_FREQUENCY;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the era to stamp into a newly allocated node
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+uint64_t IBR::birth_era(int tid) {
+
+    count_era_event(tid);
+
+    return era.load(ACQ);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Frees every retired node whose lifetime does not overlap a reserved interval
+ *
+ * @details
+ *  A node alive from its birth era to its retire era can only be referenced by a thread whose
+ *  reserved interval overlaps those eras. The reservations are copied once, then the retire list is
+ *  compacted in place around the nodes that still conflict.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void IBR::scan(int tid) {
+
+    vector<uint64_t>& lower = threads[tid].lower_snapshot;
+    vector<uint64_t>& upper = threads[tid].upper_snapshot;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        lower[i] = reservations[i].lower.load(ACQ);
+        upper[i] = reservations[i].upper.load(ACQ);
+
+    }
+
+    vector<ibr_retired_node>& retired = threads[tid].retired;
+    size_t kept = 0;
+
+    for(size_t i = 0; i < retired.size(); i++) {
+
+        bool conflict = false;
+
+        for(int j = 0; j < NUM_THREADS; j++) {
+
+            if(lower[j] != IBR_INACTIVE && lower[j] <= retired[i].retire_era && retired[i].birth_era <= upper[j]) {
+
+                conflict = true;
+                break;
+
+            }
+
+        }
+
+        if(conflict) {
+
+            retired[kept] = retired[i];
+            kept++;
+
+        }
+
+        else {
+
+            retired[i].retired.reclaim(retired[i].retired.node, retired[i].retired.context, tid);
+
+        }
+
+    }
+
+    retired.resize(kept);
+
+    // Nodes a stalled thread holds back are not rescanned until the list has doubled
+    threads[tid].scan_threshold = 2 * kept > (size_t)SCAN_FREQUENCY ? 2 * kept : SCAN_FREQUENCY;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Hands an unlinked node over to be freed once no reserved interval covers it
+ *
+ * @details
+ *  Records the node with its birth era and the current era, then scans the thread's retire list
+ *  once it reaches the scan threshold. The threshold is at least SCAN_FREQUENCY and at least twice
+ *  what survived the last scan, so each retire pays amortized constant scanning cost.
+ *
+ * @note
+ *  The node must already be unreachable from the data structure
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ * @param[in] node
+ *  Node to free
+ *
+ * @param[in] birth
+ *  Era the node was allocated in
+ *
+ * @param[in] reclaim
+ *  Function that frees the node
+ *
+ * @param[in] context
+ *  Passed through to the reclaim function
+ *
+ ******************************************************************************/
+void IBR::retire(int tid, void* node, uint64_t birth, reclaim_function reclaim, void* context) {
+
+    ibr_thread* me = &threads[tid];
+    me->retired.push_back({{node, reclaim, context}, birth, era.load(ACQ)});
+    count_era_event(tid);
+
+    if(me->retired.size() > me->peak_retired) {
+
+        me->peak_retired = me->retired.size();
+
+    }
+
+    if(me->retired.size() >= me->scan_threshold) {
+
+        scan(tid);
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the most retired nodes that were ever waiting to be freed
+ *
+ * @details
+ *  Sums the peak of every thread's retire list
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+size_t IBR::peak_unreclaimed() {
+
+    size_t peak = 0;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        peak += threads[i].peak_retired;
+
+    }
+
+    return peak;
+
+}
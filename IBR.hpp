@@ -0,0 +1,114 @@
+/*
+ * IBR.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef IBR_HPP
+#define IBR_HPP
+
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include "Reclamation.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::atomic;
+using std::vector;
+
+#define ACQREL std::memory_order_acq_rel
+#define ACQ std::memory_order_acquire
+#define RELEASE std::memory_order_release
+#define RELAXED std::memory_order_relaxed
+#define SEQ_CST std::memory_order_seq_cst
+
+#define IBR_INACTIVE UINT64_MAX
+#define IBR_ERA_FREQUENCY 64
+#define IBR_MIN_SCAN_FREQUENCY 64
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// Interval of eras a thread may hold references from, one per cache line
+struct alignas(CACHE_LINE_SIZE) ibr_reservation {
+
+    atomic<uint64_t> lower;
+    atomic<uint64_t> upper;
+
+};
+
+struct ibr_retired_node {
+
+    retired_node retired;
+    uint64_t birth_era;
+    uint64_t retire_era;
+
+};
+
+struct alignas(CACHE_LINE_SIZE) ibr_thread {
+
+    vector<ibr_retired_node> retired;
+    vector<uint64_t> lower_snapshot;
+    vector<uint64_t> upper_snapshot;
+    int era_countdown;
+    size_t scan_threshold;
+    size_t peak_retired;
+
+};
+
+class IBR {
+
+    private:
+    alignas(CACHE_LINE_SIZE) atomic<uint64_t> era;
+    ibr_reservation* reservations;
+    ibr_thread* threads;
+    int NUM_THREADS;
+    int SCAN_FREQUENCY;
+    void scan(int tid);
+    void count_era_event(int tid);
+
+    public:
+    IBR(int number_of_threads);
+    ~IBR();
+    void start_op(int tid);
+    void end_op(int tid);
+    uint64_t birth_era(int tid);
+    void retire(int tid, void* node, uint64_t birth, reclaim_function reclaim, void* context);
+    size_t peak_unreclaimed();
+
+    // Nodes carry the era they were allocated in as birth_era
+    template<typename T> void retire(int tid, T* node) { retire(tid, node, node->birth_era, &delete_node<T>, NULL); }
+
+    // Reads a shared pointer and extends the thread's interval until it covers the current era
+    template<typename T> T* protect(int tid, atomic<T*>& ptr) {
+
+        uint64_t reserved = reservations[tid].upper.load(RELAXED);
+
+        while(true) {
+
+            T* p = ptr.load(ACQ);
+            uint64_t current = era.load(ACQ);
+
+            if(current == reserved) {
+
+                return p;
+
+            }
+
+            reservations[tid].upper.store(current, SEQ_CST);
+            reserved = current;
+
+        }
+
+    }
+
+};
+
+#endif
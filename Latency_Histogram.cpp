@@ -0,0 +1,196 @@
+/**
+ * @file Latency_Histogram.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for the log linear latency histogram
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "Latency_Histogram.hpp"
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Latency_Histogram class
+ *
+ * @details
+ *  Starts the histogram empty
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Latency_Histogram::Latency_Histogram() {
+
+    clear();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Empties the histogram
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+void Latency_Histogram::clear() {
+
+    for(int i = 0; i < LH_BUCKETS; i++) {
+
+        counts[i] = 0;
+
+    }
+
+    total = 0;
+    max = 0;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the highest value that falls in a bucket
+ *
+ * @details
+ *  A bucket in group g covers 2^(g-1) values starting at (LH_SUB_BUCKETS + sub bucket) << (g-1),
+ *  group 0 buckets hold a single value each
+ *
+ * @note
+ *  none
+ *
+ * @param[in] index
+ *  Bucket index
+ *
+ ******************************************************************************/
+uint64_t Latency_Histogram::bucket_highest(int index) {
+
+    int group = index / LH_SUB_BUCKETS;
+    uint64_t sub_bucket = index % LH_SUB_BUCKETS;
+
+    if(group == 0) {
+
+        return sub_bucket;
+
+    }
+
+    int shift = group - 1;
+    uint64_t lowest = (LH_SUB_BUCKETS + sub_bucket) << shift;
+
+    return lowest + ((1ULL << shift) - 1);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Adds another histogram's values to this one
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  The other histogram's owner must be done recording
+ *
+ * @param[in] other
+ *  Histogram to add
+ *
+ ******************************************************************************/
+void Latency_Histogram::merge(const Latency_Histogram& other) {
+
+    for(int i = 0; i < LH_BUCKETS; i++) {
+
+        counts[i] += other.counts[i];
+
+    }
+
+    total += other.total;
+    max = other.max > max ? other.max : max;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the value below which the given percent of recorded values fall
+ *
+ * @details
+ *  Walks the buckets until the running count reaches the percentile's rank
+ *
+ * @note
+ *  Returns 0 if nothing was recorded
+ *
+ * @param[in] percent
+ *  Percentile between 0 and 100
+ *
+ ******************************************************************************/
+uint64_t Latency_Histogram::percentile(double percent) {
+
+    if(total == 0) {
+
+        return 0;
+
+    }
+
+    uint64_t rank = (uint64_t)(percent / 100.0 * total + 0.5);
+    rank = rank < 1 ? 1 : rank > total ? total : rank;
+
+    uint64_t seen = 0;
+
+    for(int i = 0; i < LH_BUCKETS; i++) {
+
+        seen += counts[i];
+
+        if(seen >= rank) {
+
+            uint64_t highest = bucket_highest(i);
+
+            return highest < max ? highest : max;
+
+        }
+
+    }
+
+    return max;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the number of recorded values
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+uint64_t Latency_Histogram::count() {
+
+    return total;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the largest recorded value
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+uint64_t Latency_Histogram::maximum() {
+
+    return max;
+
+}
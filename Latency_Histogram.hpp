@@ -0,0 +1,90 @@
+/*
+ * Latency_Histogram.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <stdint.h>
+#include "Reclamation.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// Every power of two range is split into 2^LH_SUB_BUCKET_BITS linear buckets, so a recorded
+// value lands in a bucket no wider than 1/32 of itself
+#define LH_SUB_BUCKET_BITS 5
+#define LH_SUB_BUCKETS (1 << LH_SUB_BUCKET_BITS)
+#define LH_BUCKETS ((64 - LH_SUB_BUCKET_BITS + 1) * LH_SUB_BUCKETS)
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  Log linear latency histogram in the style of HdrHistogram
+ *
+ * @details
+ *  Values below LH_SUB_BUCKETS each get their own bucket. Above that every power of two range
+ *  gets LH_SUB_BUCKETS buckets of equal width, so the relative error of a reported value stays
+ *  the same from nanoseconds to minutes. All buckets are part of the histogram itself, recording
+ *  is an index computation and an increment and never allocates. Each thread records into its own
+ *  histograms and they are merged once the threads are done.
+ *
+ * @note
+ *  Percentiles report the highest value of the bucket they fall in, capped at the largest value recorded
+ *
+ ******************************************************************************/
+class alignas(CACHE_LINE_SIZE) Latency_Histogram {
+
+    private:
+    uint64_t counts[LH_BUCKETS];
+    uint64_t total;
+    uint64_t max;
+
+    // Bucket of a value, the power of two range picks the group and the next bits pick the bucket in it
+    static inline int bucket(uint64_t value) {
+
+        if(value < LH_SUB_BUCKETS) {
+
+            return (int)value;
+
+        }
+
+        int magnitude = 63 - __builtin_clzll(value);
+        int shift = magnitude - LH_SUB_BUCKET_BITS;
+
+        return (shift + 1) * LH_SUB_BUCKETS + (int)((value >> shift) - LH_SUB_BUCKETS);
+
+    }
+
+    static uint64_t bucket_highest(int index);
+
+    public:
+    Latency_Histogram();
+    void clear();
+    void merge(const Latency_Histogram& other);
+    uint64_t percentile(double percent);
+    uint64_t count();
+    uint64_t maximum();
+
+    // Records one value, on the hot path so it lives here
+    inline void record(uint64_t value) {
+
+        counts[bucket(value)]++;
+        total++;
+        max = value > max ? value : max;
+
+    }
+
+};
+
+#endif
@@ -200,18 +200,43 @@ void Locks::ticket_unlock() {
 
 /***************************************************************************//**
  * @brief
- *  This is the try_acquire method rfor the pthread lock.
+ *  This is the try_acquire method for every lock algorithm.
  *
  * @details
- *  Attempts to acquire lock and returns int that indicates succesws or different types of failure
+ *  Makes a single attempt to acquire the lock. The ticket lock only takes a ticket when it is
+ *  its turn, so a failed attempt never leaves the thread queued.
  *
  * @note
- *  none
+ *  Returns 0 on success and EBUSY if the lock is held
  *
  ******************************************************************************/
 int Locks::try_acquire() {
 
-    pthread_mutex_trylock(&p_lock);
+    switch(lock) {
+
+        case(tas):{
+            return testAndSet() ? 0 : EBUSY;
+        }
+
+        case(ttas):{
+            return flag.load(SEQ_CST) == false && testAndSet() ? 0 : EBUSY;
+        }
+
+        case(ticket):{
+            int serving = now_serving.load(SEQ_CST);
+            int expected = serving;
+            return next_num.compare_exchange_strong(expected, serving + 1, SEQ_CST) ? 0 : EBUSY;
+        }
+
+        case(pthread_lock):{
+            return pthread_mutex_trylock(&p_lock);
+        }
+
+        default:{
+            assert(false);
+            return EBUSY;
+        }
+    }
 
 }
 
@@ -15,6 +15,7 @@
 #include <string>
 #include <pthread.h>
 #include <assert.h>
+#include <errno.h>
 
 //***********************************************************************************
 // defined files
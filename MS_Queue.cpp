@@ -11,6 +11,36 @@
 //***********************************************************************************
 #include "MS_Queue.hpp"
 
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  Checks whether the queue is empty for a dequeue about to take an offered enqueue
+ *
+ * @details
+ *  A dummy whose next is NULL is still the head, since next is never reset while the dummy
+ *  is protected. An enqueue and a dequeue that both span a moment where the queue is empty
+ *  can be ordered back to back at that moment without breaking FIFO order.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] context
+ *  ms_empty_check holding the queue's head and the calling thread
+ *
+ ******************************************************************************/
+static bool observed_empty(void* context) {
+
+    ms_empty_check* check = (ms_empty_check*)context;
+
+    ms_node* dummy = check->ibr != NULL ? check->ibr->protect(check->tid, *check->head) : check->head->load(ACQ);
+
+    return dummy->next.load(ACQ) == NULL;
+
+}
+
 //***********************************************************************************
 // functions
 //***********************************************************************************
@@ -20,18 +50,22 @@
  *  This is the constructor for the M&S_Stack Class
  *
  * @details
- *  Initialize the dummy ms_node and set head and tail equal to dummy
+ *  Initialize the node pool and the dummy ms_node and set head and tail equal to dummy. Only the elimination variant builds
+ *  an elimination array.
  *
  * @note
  *  none
  *
  ******************************************************************************/
-MS_queue::MS_queue() {
-    ms_node* dummy = new ms_node;
+template<optimization_variant V>
+MS_queue<V>::MS_queue(int number_of_threads) : pool(number_of_threads), elimination(number_of_threads) {
+    ms_node* dummy = pool.allocate(0);
     dummy->val = 21;
     dummy->next = NULL;
+    dummy->birth_era = 0;
     head.store(dummy, RELAXED);
     tail.store(dummy, RELAXED);
+    ibr = NULL;
 }
 
 /***************************************************************************//**
@@ -39,16 +73,80 @@ MS_queue::MS_queue() {
  *  This is the destructor for the M&S_Queue class
  *
  * @details
- *  delete head node
+ *  none
+ *
+ * @note
+ *  The dummy node and any nodes left in the queue are freed along with the node pool
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+MS_queue<V>::~MS_queue() {
+
+    head.store(NULL, RELAXED);
+    tail.store(NULL, RELAXED);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the pool the queue allocates its nodes from
+ *
+ * @details
+ *  Dequeued nodes are retired with Node_Pool::reclaim and this pool as the context, so they are
+ *  recycled instead of going back to malloc
  *
  * @note
  *  none
  *
  ******************************************************************************/
-MS_queue::~MS_queue() {
+template<optimization_variant V>
+Node_Pool<ms_node>* MS_queue<V>::node_pool() {
+
+    return &pool;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the queue's elimination array
+ *
+ * @details
+ *  Used to report the elimination hit rate
+ *
+ * @note
+ *  NULL unless this is the elimination variant
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+Elimination_Array* MS_queue<V>::elimination_array() {
+
+    if constexpr(V == elimination_variant) {
+        return &elimination;
+    }
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Has the queue read head and tail through interval based reclamation
+ *
+ * @details
+ *  Once set, enqueue and dequeue protect the nodes they dereference and new nodes are stamped
+ *  with their birth era
+ *
+ * @note
+ *  Set before any thread uses the queue
+ *
+ * @param[in] interval_reclamation
+ *  Reclamation instance the dequeued nodes will be retired to
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+void MS_queue<V>::set_ibr(IBR* interval_reclamation) {
 
-    ms_node* garbage = head.load();
-    delete(garbage);
+    ibr = interval_reclamation;
 
 }
 
@@ -58,6 +156,8 @@ MS_queue::~MS_queue() {
  *
  * @details
  *  Places new ms_node in the queue. Uses atomic operators (CAS) to create linearization points for the threads. 
+ *  Elimination optimization relieves contention on the tail. An enqueue that loses the CAS on the last node offers
+ *  its node in the elimination array, where a dequeue that finds the queue empty can take it directly.
  *
  * @note
  * 	Funtion attempts to update imposter tail, but update is not guaranteed
@@ -65,30 +165,50 @@ MS_queue::~MS_queue() {
  * @param[in] val
  *  Value of the new ms_node
  *
+ * @param[in] tid
+ *  Calling thread
+ *
  ******************************************************************************/
-void MS_queue::enqueue(int val) {
+template<optimization_variant V>
+void MS_queue<V>::enqueue(int val, int tid) {
 
     ms_node *imposter_tail, *true_end, *new_ms_node;
-    new_ms_node = new ms_node;
+    new_ms_node = pool.allocate(tid);
     new_ms_node->val = val;
+    new_ms_node->next.store(NULL, RELAXED);
+    new_ms_node->birth_era = ibr != NULL ? ibr->birth_era(tid) : 0;
 
     while(true) {
 
-        imposter_tail = tail.load(ACQ);
+        imposter_tail = ibr != NULL ? ibr->protect(tid, tail) : tail.load(ACQ);
 
         true_end = imposter_tail->next.load(ACQ);
 
 
         if(imposter_tail == tail.load(ACQ)) {
 
-            if(true_end == NULL && imposter_tail->next.compare_exchange_strong(true_end, new_ms_node)) {
-                
-                break;
+            if(true_end == NULL) {
+
+                if(imposter_tail->next.compare_exchange_strong(true_end, new_ms_node)) {
+
+                    break;
+
+                }
+
+                // The dequeuing thread takes ownership of the node
+                if constexpr(V == elimination_variant) {
+
+                    if(elimination.offer(tid, new_ms_node)) {
+
+                        return;
+
+                    }
+
+                }
 
             }
-            
 
-            else if(true_end != NULL) {
+            else {
 
                 tail.compare_exchange_strong(imposter_tail, true_end);
 
@@ -107,21 +227,31 @@ void MS_queue::enqueue(int val) {
  *  This is the dequeue method for the M&S_Queue class
  *
  * @details
- *  Function dequeues and returns the value of the dequeued ms_node. Uses atomic operators (CAS) to create linearization points for the threads.
+ *  Function dequeues and returns the old dummy ms_node, which the caller retires. Uses atomic operators (CAS) to create linearization points for the threads.
+ *  With elimination optimization, a dequeue that finds the queue empty tries to take the node of a pending enqueue instead, and
+ *  returns that node for the caller to retire.
  *
  * @note
- * 	Function will return a node with a value of -1 when the queue is empty
+ * 	Function will return NULL when the queue is empty. The returned node is the old dummy, so the dequeued value
+ *  is only available through value.
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ * @param[out] value
+ *  Dequeued value, left alone when the queue is empty. May be NULL
  *
  ******************************************************************************/
-ms_node* MS_queue::dequeue() {
+template<optimization_variant V>
+ms_node* MS_queue<V>::dequeue(int tid, int* value) {
 
     ms_node *dummy, *new_dummy, *imposter_tail;
 
     while(true) {
 
-        dummy = head.load(ACQ);
+        dummy = ibr != NULL ? ibr->protect(tid, head) : head.load(ACQ);
         imposter_tail = tail.load(ACQ);
-        new_dummy = dummy->next.load(ACQ);
+        new_dummy = ibr != NULL ? ibr->protect(tid, dummy->next) : dummy->next.load(ACQ);
 
 
         if(dummy == head.load(ACQ)) {
@@ -130,8 +260,26 @@ ms_node* MS_queue::dequeue() {
 
                 if(new_dummy == NULL) {
 
-                    dummy->val = -1;
-                    return dummy;
+                    if constexpr(V == elimination_variant) {
+
+                        ms_empty_check check = {&head, ibr, tid};
+                        ms_node* eliminated = (ms_node*)elimination.take(tid, &observed_empty, &check);
+
+                        if(eliminated != NULL) {
+
+                            if(value != NULL) {
+
+                                *value = eliminated->val;
+
+                            }
+
+                            return eliminated;
+
+                        }
+
+                    }
+
+                    return NULL;
 
                 }
 
@@ -147,6 +295,9 @@ ms_node* MS_queue::dequeue() {
 
                 int ret = new_dummy->val;
                 if(head.compare_exchange_strong(dummy, new_dummy, ACQREL)) {
+                    if(value != NULL) {
+                        *value = ret;
+                    }
                     return dummy;
                 }
 
@@ -156,4 +307,175 @@ ms_node* MS_queue::dequeue() {
 
     } 
 
-}
\ No newline at end of file
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Enqueues a batch of values with a single CAS on the last node
+ *
+ * @details
+ *  The batch is linked into a private segment first, so no other thread can see it until the CAS
+ *  on the last node's next appends the whole segment. The tail is then swung to the end of the
+ *  segment. If that CAS fails the tail lags inside the segment, and other threads help it forward
+ *  one node at a time like they do for a single enqueue.
+ *
+ * @note
+ * 	Bulk enqueues do not use the elimination array
+ *
+ * @param[in] vals
+ *  Values to enqueue, vals[0] is dequeued first
+ *
+ * @param[in] count
+ *  Number of values
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+void MS_queue<V>::enqueue_bulk(int* vals, int count, int tid) {
+
+    if(count <= 0) {
+
+        return;
+
+    }
+
+    ms_node *imposter_tail, *true_end, *first, *last;
+    uint64_t birth_era = ibr != NULL ? ibr->birth_era(tid) : 0;
+
+    first = NULL;
+    last = NULL;
+
+    for(int i = count - 1; i >= 0; i--) {
+
+        ms_node* n = pool.allocate(tid);
+        n->val = vals[i];
+        n->next.store(first, RELAXED);
+        n->birth_era = birth_era;
+
+        if(last == NULL) {
+
+            last = n;
+
+        }
+
+        first = n;
+
+    }
+
+    while(true) {
+
+        imposter_tail = ibr != NULL ? ibr->protect(tid, tail) : tail.load(ACQ);
+
+        true_end = imposter_tail->next.load(ACQ);
+
+
+        if(imposter_tail == tail.load(ACQ)) {
+
+            if(true_end == NULL) {
+
+                if(imposter_tail->next.compare_exchange_strong(true_end, first)) {
+
+                    break;
+
+                }
+
+            }
+
+            else {
+
+                tail.compare_exchange_strong(imposter_tail, true_end);
+
+            }
+
+        }
+
+    }
+
+    tail.compare_exchange_strong(imposter_tail, last);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Dequeues up to n values with a single CAS on head
+ *
+ * @details
+ *  Walks up to n nodes past the dummy and swings head to the last one, which becomes the new dummy.
+ *  Head must never pass the tail, or an enqueue could append to a node that was already retired, so
+ *  the walk helps the tail past every node it visits. Returns the old dummy followed by the other
+ *  dequeued nodes, linked through next, for the caller to retire.
+ *
+ * @note
+ * 	Function will return NULL when the queue is empty. The last returned node still links to the new
+ *  dummy, so the caller stops after the number of nodes in dequeued.
+ *
+ * @param[in] n
+ *  Most values to dequeue
+ *
+ * @param[out] dequeued
+ *  Number of values dequeued, which is also the number of returned nodes
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+ms_node* MS_queue<V>::dequeue_bulk(int n, int* dequeued, int tid) {
+
+    ms_node *dummy, *new_dummy, *next;
+
+    while(true) {
+
+        dummy = ibr != NULL ? ibr->protect(tid, head) : head.load(ACQ);
+        new_dummy = dummy;
+        int count = 0;
+
+        while(count < n) {
+
+            next = ibr != NULL ? ibr->protect(tid, new_dummy->next) : new_dummy->next.load(ACQ);
+
+            if(next == NULL) {
+
+                break;
+
+            }
+
+            ms_node* imposter_tail = new_dummy;
+            tail.compare_exchange_strong(imposter_tail, next, ACQREL);
+
+            new_dummy = next;
+            count++;
+
+        }
+
+        if(count == 0) {
+
+            if(dummy == head.load(ACQ)) {
+
+                *dequeued = 0;
+
+                return NULL;
+
+            }
+
+            continue;
+
+        }
+
+        if(head.compare_exchange_strong(dummy, new_dummy, ACQREL)) {
+
+            *dequeued = count;
+
+            return dummy;
+
+        }
+
+    }
+
+}
+
+// Variants of the M&S queue
+template class MS_queue<base_variant>;
+template class MS_queue<elimination_variant>;
@@ -13,6 +13,11 @@
 
 #include <iostream>
 #include <atomic>
+#include <stdint.h>
+#include "IBR.hpp"
+#include "Node_Pool.hpp"
+#include "Elimination_Array.hpp"
+#include "Optimization_Variant.hpp"
 
 //***********************************************************************************
 // defined files
@@ -32,19 +37,41 @@ struct ms_node {
 
     int val;
     atomic<ms_node*> next;
+    uint64_t birth_era;
 
 };
 
+// Handed to the elimination array so a dequeue can check the queue is empty before taking an offer
+struct ms_empty_check {
+
+    atomic<ms_node*>* head;
+    IBR* ibr;
+    int tid;
+
+};
+
+// Built as base_variant and elimination_variant
+template<optimization_variant V>
 class MS_queue{
 
+    static_assert(V == base_variant || V == elimination_variant, "The M&S queue only has base and elimination variants");
+
     private:
     atomic<ms_node*> head, tail;
+    IBR* ibr;
+    Node_Pool<ms_node> pool;
+    variant_state<V == elimination_variant, Elimination_Array> elimination;
 
     public:
-    MS_queue();
+    MS_queue(int number_of_threads);
     ~MS_queue();
-    void enqueue(int val);
-    ms_node* dequeue();
+    void set_ibr(IBR* interval_reclamation);
+    Node_Pool<ms_node>* node_pool();
+    Elimination_Array* elimination_array();
+    void enqueue(int val, int tid);
+    ms_node* dequeue(int tid, int* value = NULL);
+    void enqueue_bulk(int* vals, int count, int tid);
+    ms_node* dequeue_bulk(int n, int* dequeued, int tid);
 
 };
 
@@ -0,0 +1,297 @@
+/*
+ * Node_Pool.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <stdlib.h>
+#include <new>
+#include <vector>
+#include <type_traits>
+#include "Locks.hpp"
+#include "Reclamation.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::vector;
+
+#define POOL_MAGAZINE_SIZE 64
+#define POOL_SLAB_BYTES (64 * 1024)
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// A fixed size stack of free nodes that moves between a thread and the depot as a unit
+template<typename T>
+struct pool_magazine {
+
+    int count;
+    T* nodes[POOL_MAGAZINE_SIZE];
+    pool_magazine<T>* next;
+
+};
+
+// Each thread allocates from loaded and keeps previous as a spare, one per cache line
+template<typename T>
+struct alignas(CACHE_LINE_SIZE) pool_cache {
+
+    pool_magazine<T>* loaded;
+    pool_magazine<T>* previous;
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  Per thread node allocator backed by a shared depot
+ *
+ * @details
+ *  Threads allocate and free nodes through their own pair of magazines without any
+ *  synchronization. Only when both magazines are empty (or both full) does a thread take
+ *  the depot lock, and then it swaps a whole magazine of POOL_MAGAZINE_SIZE nodes at once.
+ *  When the depot runs dry a cache line aligned slab is carved into full magazines. Nodes
+ *  are never returned to malloc while the pool exists, the slabs are freed with the pool.
+ *
+ * @note
+ *  Nodes come back exactly as they were released, callers initialize every field
+ *
+ ******************************************************************************/
+template<typename T>
+class Node_Pool {
+
+    static_assert(std::is_trivially_destructible<T>::value, "Pool nodes are freed with their slab");
+
+    private:
+    pool_cache<T>* caches;
+    int NUM_THREADS;
+    Locks depot_lock;
+    pool_magazine<T>* full_magazines;
+    pool_magazine<T>* empty_magazines;
+    vector<void*> slabs;
+
+    pool_magazine<T>* new_magazine() {
+
+        pool_magazine<T>* magazine = new pool_magazine<T>;
+        magazine->count = 0;
+        magazine->next = NULL;
+
+        return magazine;
+
+    }
+
+    void free_magazines(pool_magazine<T>* magazine) {
+
+        while(magazine != NULL) {
+
+            pool_magazine<T>* next = magazine->next;
+            delete(magazine);
+            magazine = next;
+
+        }
+
+    }
+
+    // Carves a new slab into full magazines, called with the depot lock held. Throws
+    // std::bad_alloc like new would if the slab can not be allocated.
+    void carve_slab() {
+
+        size_t nodes_per_slab = POOL_SLAB_BYTES / sizeof(T);
+        char* slab = (char*)aligned_alloc(CACHE_LINE_SIZE, POOL_SLAB_BYTES);
+
+        if(slab == NULL) {
+            throw std::bad_alloc();
+        }
+
+        slabs.push_back(slab);
+
+        pool_magazine<T>* magazine = NULL;
+
+        for(size_t i = 0; i < nodes_per_slab; i++) {
+
+            if(magazine == NULL || magazine->count == POOL_MAGAZINE_SIZE) {
+
+                magazine = new_magazine();
+                magazine->next = full_magazines;
+                full_magazines = magazine;
+
+            }
+
+            magazine->nodes[magazine->count] = new(slab + i * sizeof(T)) T;
+            magazine->count++;
+
+        }
+
+    }
+
+    // Trades an empty magazine for a full one from the depot
+    pool_magazine<T>* exchange_empty(pool_magazine<T>* empty) {
+
+        depot_lock.acquire();
+
+        if(full_magazines == NULL) {
+
+            // The depot stays usable if the allocation fails
+            try {
+                carve_slab();
+            }
+            catch(...) {
+                depot_lock.release();
+                throw;
+            }
+
+        }
+
+        pool_magazine<T>* full = full_magazines;
+        full_magazines = full->next;
+
+        empty->next = empty_magazines;
+        empty_magazines = empty;
+
+        depot_lock.release();
+
+        return full;
+
+    }
+
+    // Trades a full magazine for an empty one from the depot
+    pool_magazine<T>* exchange_full(pool_magazine<T>* full) {
+
+        depot_lock.acquire();
+
+        full->next = full_magazines;
+        full_magazines = full;
+
+        pool_magazine<T>* empty = empty_magazines;
+
+        if(empty != NULL) {
+
+            empty_magazines = empty->next;
+
+        }
+
+        depot_lock.release();
+
+        if(empty == NULL) {
+
+            empty = new_magazine();
+
+        }
+
+        return empty;
+
+    }
+
+    public:
+    Node_Pool(int number_of_threads) : depot_lock("pthread") {
+
+        NUM_THREADS = number_of_threads;
+        full_magazines = NULL;
+        empty_magazines = NULL;
+        caches = new pool_cache<T>[number_of_threads];
+
+        for(int i = 0; i < number_of_threads; i++) {
+
+            caches[i].loaded = new_magazine();
+            caches[i].previous = new_magazine();
+
+        }
+
+    }
+
+    ~Node_Pool() {
+
+        for(int i = 0; i < NUM_THREADS; i++) {
+
+            delete(caches[i].loaded);
+            delete(caches[i].previous);
+
+        }
+
+        free_magazines(full_magazines);
+        free_magazines(empty_magazines);
+
+        for(size_t i = 0; i < slabs.size(); i++) {
+
+            free(slabs[i]);
+
+        }
+
+        delete [] caches;
+
+    }
+
+    T* allocate(int tid) {
+
+        pool_cache<T>* cache = &caches[tid];
+
+        if(cache->loaded->count == 0) {
+
+            pool_magazine<T>* spare = cache->previous;
+
+            if(spare->count > 0) {
+
+                cache->previous = cache->loaded;
+                cache->loaded = spare;
+
+            }
+
+            else {
+
+                cache->loaded = exchange_empty(cache->loaded);
+
+            }
+
+        }
+
+        cache->loaded->count--;
+
+        return cache->loaded->nodes[cache->loaded->count];
+
+    }
+
+    void release(int tid, T* node) {
+
+        pool_cache<T>* cache = &caches[tid];
+
+        if(cache->loaded->count == POOL_MAGAZINE_SIZE) {
+
+            pool_magazine<T>* spare = cache->previous;
+
+            if(spare->count < POOL_MAGAZINE_SIZE) {
+
+                cache->previous = cache->loaded;
+                cache->loaded = spare;
+
+            }
+
+            else {
+
+                cache->loaded = exchange_full(cache->loaded);
+
+            }
+
+        }
+
+        cache->loaded->nodes[cache->loaded->count] = node;
+        cache->loaded->count++;
+
+    }
+
+    // Reclaim function for the reclamation schemes, the pool is passed as the context
+    static void reclaim(void* node, void* context, int tid) {
+
+        ((Node_Pool<T>*)context)->release(tid, (T*)node);
+
+    }
+
+};
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Optimization_Variant.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef OPTIMIZATION_VARIANT_HPP
+#define OPTIMIZATION_VARIANT_HPP
+
+#include <type_traits>
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// Data structures take the variant as a template argument, so every variant is its own type
+// and the unused paths compile away. Each structure instantiates the variants it supports.
+enum optimization_variant {
+
+    base_variant,
+    elimination_variant,
+    flat_combining_variant,
+    two_lock_variant,
+    unrolled_variant
+
+};
+
+// Stands in for the state of a variant that is not being built. It takes the same constructor
+// arguments as the state it replaces and ignores them, so nothing is allocated for it.
+struct no_variant_state {
+
+    template<typename... Args>
+    no_variant_state(Args&&...) {}
+
+};
+
+// A member only the given variants use, every other variant gets an empty stand in. Code that
+// touches the member goes behind if constexpr on the same condition.
+template<bool used, typename T>
+using variant_state = std::conditional_t<used, T, no_variant_state>;
+
+#endif
@@ -0,0 +1,295 @@
+/**
+ * @file Perf_Counters.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for the per thread hardware performance counter groups
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "Perf_Counters.hpp"
+
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+static const char* event_names[perf_counter_events] = {
+
+    "Cycles",
+    "Instructions",
+    "Cache misses",
+    "LLC misses",
+    "Branch misses",
+    "HITM"
+
+};
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Perf_Counters class
+ *
+ * @details
+ *  Starts with no counters open
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Perf_Counters::Perf_Counters() {
+
+    group_size = 0;
+
+    for(int i = 0; i < perf_counter_events; i++) {
+
+        fds[i] = -1;
+        values[i] = 0;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the Perf_Counters class
+ *
+ * @details
+ *  Closes every counter that was opened
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Perf_Counters::~Perf_Counters() {
+
+    for(int i = 0; i < perf_counter_events; i++) {
+
+        if(fds[i] != -1) {
+
+            close(fds[i]);
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Opens one counter for the calling thread
+ *
+ * @details
+ *  The group leader starts disabled, members follow the leader. Returns the file descriptor or
+ *  -1 with errno set.
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+int Perf_Counters::open_event(uint32_t type, uint64_t config, int group_fd) {
+
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.disabled = group_fd == -1 ? 1 : 0;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return syscall(SYS_perf_event_open, &attributes, 0, -1, group_fd, 0);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Opens the counter group for the calling thread
+ *
+ * @details
+ *  Returns 0 if at least the cycle counter opened, otherwise the errno of the failed open. An
+ *  event the other counters can not be grouped with is left unavailable.
+ *
+ * @note
+ *  Call from the thread to be counted, before the timed region
+ *
+ * @param[in] hitm_raw
+ *  Model specific raw event code counting loads that hit a modified line in another core, or PERF_NO_RAW_EVENT
+ *
+ ******************************************************************************/
+int Perf_Counters::open(uint64_t hitm_raw) {
+
+    uint32_t types[perf_counter_events] = {
+
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_RAW
+
+    };
+
+    uint64_t configs[perf_counter_events] = {
+
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_BRANCH_MISSES,
+        hitm_raw
+
+    };
+
+    fds[cycles_event] = open_event(types[cycles_event], configs[cycles_event], -1);
+
+    if(fds[cycles_event] == -1) {
+
+        return errno;
+
+    }
+
+    group_order[0] = cycles_event;
+    group_size = 1;
+
+    for(int i = cycles_event + 1; i < perf_counter_events; i++) {
+
+        if(i == hitm_event && hitm_raw == PERF_NO_RAW_EVENT) {
+
+            continue;
+
+        }
+
+        fds[i] = open_event(types[i], configs[i], fds[cycles_event]);
+
+        if(fds[i] != -1) {
+
+            group_order[group_size] = i;
+            group_size++;
+
+        }
+
+    }
+
+    return 0;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Starts counting
+ *
+ * @details
+ *  Resets and enables the whole group at once
+ *
+ * @note
+ *  Does nothing if the group did not open
+ *
+ ******************************************************************************/
+void Perf_Counters::start() {
+
+    if(group_size == 0) {
+
+        return;
+
+    }
+
+    ioctl(fds[cycles_event], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[cycles_event], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Stops counting and reads the counts
+ *
+ * @details
+ *  The group is read in one call. Counts are scaled if the group only ran for part of the time it was enabled.
+ *
+ * @note
+ *  Does nothing if the group did not open
+ *
+ ******************************************************************************/
+void Perf_Counters::stop() {
+
+    if(group_size == 0) {
+
+        return;
+
+    }
+
+    ioctl(fds[cycles_event], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // Number of events, time enabled, time running, then one count per event in the order they joined
+    uint64_t group[3 + perf_counter_events];
+
+    if(read(fds[cycles_event], group, sizeof(group)) < (ssize_t)((3 + group_size) * sizeof(uint64_t))) {
+
+        return;
+
+    }
+
+    double scale = group[2] > 0 ? (double)group[1] / group[2] : 0.0;
+
+    for(int i = 0; i < group_size; i++) {
+
+        values[group_order[i]] = (uint64_t)(group[3 + i] * scale);
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns whether an event was counted
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+bool Perf_Counters::available(perf_counter_event event) {
+
+    return fds[event] != -1;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns an event's count over the timed region
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  0 if the event was not counted
+ *
+ ******************************************************************************/
+uint64_t Perf_Counters::value(perf_counter_event event) {
+
+    return values[event];
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the printed name of an event
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+const char* Perf_Counters::name(perf_counter_event event) {
+
+    return event_names[event];
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Perf_Counters.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+
+// The HITM event has no generic encoding, 0 means no raw code was given
+#define PERF_NO_RAW_EVENT 0
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+enum perf_counter_event {
+
+    cycles_event,
+    instructions_event,
+    cache_misses_event,
+    llc_misses_event,
+    branch_misses_event,
+    hitm_event,
+    perf_counter_events
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  One thread's group of hardware performance counters
+ *
+ * @details
+ *  Cycles lead the group and every other event joins it, so they are enabled, disabled and
+ *  scheduled onto the PMU together and their counts cover the same instructions. Events the
+ *  CPU or the kernel do not support are left out of the group, and HITM is only opened when
+ *  a raw event code for this CPU model is given. When the kernel multiplexes the group the
+ *  counts are scaled up by the time the group was enabled over the time it actually ran.
+ *
+ * @note
+ *  Counters only count the thread that opened them, and only in user space so the default
+ *  perf_event_paranoid setting allows them
+ *
+ ******************************************************************************/
+class Perf_Counters {
+
+    private:
+    int fds[perf_counter_events];
+    int group_order[perf_counter_events];
+    int group_size;
+    uint64_t values[perf_counter_events];
+    int open_event(uint32_t type, uint64_t config, int group_fd);
+
+    public:
+    Perf_Counters();
+    ~Perf_Counters();
+    int open(uint64_t hitm_raw);
+    void start();
+    void stop();
+    bool available(perf_counter_event event);
+    uint64_t value(perf_counter_event event);
+    static const char* name(perf_counter_event event);
+
+};
+
+#endif
@@ -0,0 +1,258 @@
+/**
+ * @file QSBR.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for quiescent state based reclamation of retired nodes
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "QSBR.hpp"
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the QSBR class
+ *
+ * @details
+ *  Starts the grace period counter at zero with every thread having observed it
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+QSBR::QSBR(int number_of_threads) {
+
+    NUM_THREADS = number_of_threads;
+
+    grace_period.store(0, RELEASE);
+    announcements = new qsbr_announcement[number_of_threads];
+    threads = new qsbr_thread[number_of_threads];
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        announcements[i].period.store(0, RELEASE);
+        threads[i].waiting_period = 0;
+        threads[i].peak_retired = 0;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the QSBR class
+ *
+ * @details
+ *  Frees every batch that is still filling or waiting on a grace period
+ *
+ * @note
+ *  Only call once all threads using the data structures have been joined
+ *
+ ******************************************************************************/
+QSBR::~QSBR() {
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        free_batch(i, threads[i].waiting);
+        free_batch(i, threads[i].filling);
+
+    }
+
+    delete [] announcements;
+    delete [] threads;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Frees every node in a batch
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Thread doing the freeing
+ *
+ * @param[in] batch
+ *  Retired nodes to free
+ *
+ ******************************************************************************/
+void QSBR::free_batch(int tid, vector<retired_node>& batch) {
+
+    for(size_t i = 0; i < batch.size(); i++) {
+
+        batch[i].reclaim(batch[i].node, batch[i].context, tid);
+
+    }
+
+    batch.clear();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Checks whether every thread has passed a quiescent state since a grace period started
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  Offline threads never hold the grace period open
+ *
+ * @param[in] period
+ *  Grace period to check
+ *
+ ******************************************************************************/
+bool QSBR::grace_period_over(uint64_t period) {
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        uint64_t observed = announcements[i].period.load(ACQ);
+
+        if(observed != QSBR_OFFLINE && observed < period) {
+
+            return false;
+
+        }
+
+    }
+
+    return true;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Announces that the calling thread holds no references into any data structure
+ *
+ * @details
+ *  Publishes the current grace period as observed by the thread. This is the only cost paid by
+ *  readers, operations themselves run without any announcement. If the thread has a batch waiting,
+ *  the batch is freed once every thread has announced its grace period, and a full filling batch
+ *  then starts waiting on a new grace period.
+ *
+ * @note
+ *  Call between operations, never while holding a node returned by a data structure
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void QSBR::quiescent(int tid) {
+
+    announcements[tid].period.store(grace_period.load(ACQ), RELEASE);
+
+    qsbr_thread* me = &threads[tid];
+
+    if(!me->waiting.empty() && grace_period_over(me->waiting_period)) {
+
+        free_batch(tid, me->waiting);
+
+        if(me->filling.size() >= QSBR_BATCH_SIZE) {
+
+            me->waiting.swap(me->filling);
+            me->waiting_period = grace_period.fetch_add(1, ACQREL) + 1;
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Removes the calling thread from grace period detection
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  Call once a thread is done with the data structures so it does not stall other threads
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void QSBR::offline(int tid) {
+
+    announcements[tid].period.store(QSBR_OFFLINE, RELEASE);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Hands an unlinked node over to be freed after the next grace period
+ *
+ * @details
+ *  Nodes are collected in the filling batch. Once QSBR_BATCH_SIZE nodes have been collected
+ *  and no batch is waiting, the filling batch starts waiting and a new grace period begins.
+ *
+ * @note
+ *  The node must already be unreachable from the data structure
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ * @param[in] node
+ *  Node to free
+ *
+ * @param[in] reclaim
+ *  Function that frees the node
+ *
+ * @param[in] context
+ *  Passed through to the reclaim function
+ *
+ ******************************************************************************/
+void QSBR::retire(int tid, void* node, reclaim_function reclaim, void* context) {
+
+    qsbr_thread* me = &threads[tid];
+    me->filling.push_back({node, reclaim, context});
+
+    if(me->filling.size() + me->waiting.size() > me->peak_retired) {
+
+        me->peak_retired = me->filling.size() + me->waiting.size();
+
+    }
+
+    if(me->filling.size() >= QSBR_BATCH_SIZE && me->waiting.empty()) {
+
+        me->waiting.swap(me->filling);
+        me->waiting_period = grace_period.fetch_add(1, ACQREL) + 1;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the most retired nodes that were ever waiting to be freed
+ *
+ * @details
+ *  Sums the peak of every thread's filling and waiting batches
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+size_t QSBR::peak_unreclaimed() {
+
+    size_t peak = 0;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        peak += threads[i].peak_retired;
+
+    }
+
+    return peak;
+
+}
@@ -0,0 +1,74 @@
+/*
+ * QSBR.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef QSBR_HPP
+#define QSBR_HPP
+
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include "Reclamation.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::atomic;
+using std::vector;
+
+#define ACQREL std::memory_order_acq_rel
+#define ACQ std::memory_order_acquire
+#define RELEASE std::memory_order_release
+
+#define QSBR_OFFLINE UINT64_MAX
+#define QSBR_BATCH_SIZE 128
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// Last grace period each thread has observed from a quiescent state, one per cache line
+struct alignas(CACHE_LINE_SIZE) qsbr_announcement {
+
+    atomic<uint64_t> period;
+
+};
+
+// The filling batch collects retires, the waiting batch is freed once its grace period ends
+struct alignas(CACHE_LINE_SIZE) qsbr_thread {
+
+    vector<retired_node> filling;
+    vector<retired_node> waiting;
+    uint64_t waiting_period;
+    size_t peak_retired;
+
+};
+
+class QSBR {
+
+    private:
+    alignas(CACHE_LINE_SIZE) atomic<uint64_t> grace_period;
+    qsbr_announcement* announcements;
+    qsbr_thread* threads;
+    int NUM_THREADS;
+    bool grace_period_over(uint64_t period);
+    void free_batch(int tid, vector<retired_node>& batch);
+
+    public:
+    QSBR(int number_of_threads);
+    ~QSBR();
+    void quiescent(int tid);
+    void offline(int tid);
+    void retire(int tid, void* node, reclaim_function reclaim, void* context);
+    size_t peak_unreclaimed();
+    template<typename T> void retire(int tid, T* node) { retire(tid, node, &delete_node<T>, NULL); }
+
+};
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * Reclamation.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef RECLAMATION_HPP
+#define RECLAMATION_HPP
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+#define CACHE_LINE_SIZE 64
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// Called once a retired node can no longer be reached by any thread. The tid is the
+// thread doing the freeing, so per-thread allocators can take the node back.
+typedef void (*reclaim_function)(void* node, void* context, int tid);
+
+struct retired_node {
+
+    void* node;
+    reclaim_function reclaim;
+    void* context;
+
+};
+
+// Default reclaim function, hands the node back to the global allocator
+template<typename T>
+void delete_node(void* node, void* context, int tid) {
+
+    delete((T*)node);
+
+}
+
+#endif
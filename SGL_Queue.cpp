@@ -17,402 +17,575 @@
 
 /***************************************************************************//**
  * @brief
- *  This is the constructor for the SGL_Queue class
+ *  This is the constructor for the Seq_queue class
  *
  * @details
- *  Initialize the global lock  and dummy sglQ_node. Set head and tail to equal tp dummy.
- *  If optimization is turned on, initialize the flat combining array.  
+ *  Starts the queue empty
  *
  * @note
  *  none
  *
+ * @param[in] node_pool
+ *  Pool the queue allocates and frees its nodes through
+ *
  ******************************************************************************/
-SGL_Queue::SGL_Queue(int number_of_threads) {
+Seq_queue::Seq_queue(Node_Pool<lq_node>* node_pool) {
 
     head = NULL;
     tail = NULL;
-
-    #ifdef FLAT_COMBINING_OPTIMIZATION_ON
-
-    NUM_THREADS = number_of_threads;
-    flat_combining_array = new atomic<sglQ_operations*>[number_of_threads];
-
-    for(int i = 0; i < number_of_threads; i++) {
-
-        flat_combining_array[i].store(NULL);
-
-    }
-
-    #endif
+    pool = node_pool;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is the destructor for the SGL_Queue class
+ *  Enqueues an already allocated lq_node
  *
  * @details
- *  Deletes the flat combining array if it was created
+ *  none
  *
  * @note
- *  none
+ *  Only call while holding the queue's lock
+ *
+ * @param[in] node
+ *  Node holding the enqueued value
  *
  ******************************************************************************/
-SGL_Queue::~SGL_Queue() {
+void Seq_queue::enqueue_node(lq_node* node) {
 
-    #ifdef FLAT_COMBINING_OPTIMIZATION_ON
+    node->next = NULL;
 
-    delete [] flat_combining_array;
+    if(!head || !tail) {
 
-    #endif
+        head = node;
+        tail = node;
+
+    }
+
+    else {
+
+        tail->next = node;
+        tail = node;
+
+    }
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is the dequeue method for the SGL_Queue class
+ *  Dequeues the head lq_node and returns its value
  *
  * @details
- *  Function dequeues and returns the value of the dequeued sglQ_node. Flat combining optimization makes it so lock holder
- *  performs all the operartions in the array. Non lock holders, place their operations in the array. Every thread contends on lock after 
- *  placing operation in the array. 
- *  
+ *  The dequeued node goes straight back to the pool
  *
  * @note
- * 	Function will return -1 if queue is empty
+ *  Only call while holding the queue's lock. Returns -1 if the queue is empty
+ *
+ * @param[in] tid
+ *  Thread whose pool magazine takes the node
  *
  ******************************************************************************/
-int SGL_Queue::dequeue(Locks* lock, int tid) {
+int Seq_queue::dequeue(int tid) {
 
-    #ifdef FLAT_COMBINING_OPTIMIZATION_ON
+    // Queue is empty
+    if(!head || !tail) {
 
-    // Non lock holder
-    while(lock->try_acquire() == EBUSY) {
+        return -1;
 
-        // Not lock holder, so place operation into combining array
-        sglQ_operations* operation = new sglQ_operations;
-        operation->dequeue = true;
-        operation->enqueue = false;
+    }
 
-        while(true) {
+    lq_node* temp = head;
+    int value = temp->val;
 
-            sglQ_operations* current_index = flat_combining_array[tid].load(ACQ);
-            if(flat_combining_array[tid].compare_exchange_strong(current_index,operation,ACQREL)) {
+    if(head == tail) {
 
-                while(lock->try_acquire() == EBUSY) {}
-                break;
+        head = NULL;
+        tail = NULL;
 
-            }
+    }
 
-        }
+    else {
 
-        break;
+        head = head->next;
 
     }
 
-    for(int i = 0; i < NUM_THREADS; i++) {
+    pool->release(tid, temp);
 
-        sglQ_operations* current_operation = flat_combining_array[i].load(ACQ);
+    return value;
 
-        if(current_operation != NULL) {
+}
 
-            // Making sure no other thread has changed the operation. Make index NULL. 
-            if(flat_combining_array[i].compare_exchange_strong(current_operation,NULL)) {
+/***************************************************************************//**
+ * @brief
+ *  Performs a published operation for the flat combiner
+ *
+ * @details
+ *  A dequeue leaves the dequeued value in the operation
+ *
+ * @note
+ *  Only call while holding the queue's lock
+ *
+ * @param[in] op
+ *  Operation to perform
+ *
+ * @param[in] tid
+ *  Combining thread
+ *
+ ******************************************************************************/
+void Seq_queue::apply(lq_operation& op, int tid) {
 
-                // perform enqueue
-                if(current_operation->enqueue) {
+    if(op.enqueue) {
 
-                    lq_node* new_lq_node = new lq_node;
-                    new_lq_node->val = current_operation->enqueue_value;
-                    new_lq_node->next = NULL;
+        lq_node* node = pool->allocate(tid);
+        node->val = op.value;
+        enqueue_node(node);
 
-                    if(!head || !tail) {
+    }
 
-                        head = new_lq_node;
-                        tail = new_lq_node;
+    else {
 
-                    }
+        op.value = dequeue(tid);
 
-                    else {
+    }
 
-                        tail->next = new_lq_node;
-                        tail = new_lq_node;
+}
 
-                    }
+/***************************************************************************//**
+ * @brief
+ *  Performs one combining pass for the flat combiner
+ *
+ * @details
+ *  Operations are applied in publication list order
+ *
+ * @note
+ *  Only called by the combiner while it holds the queue's lock
+ *
+ * @param[in] ops
+ *  Operations published for this pass
+ *
+ * @param[in] count
+ *  Number of operations
+ *
+ * @param[in] tid
+ *  Combining thread
+ *
+ ******************************************************************************/
+void Seq_queue::apply_batch(lq_operation** ops, int count, int tid) {
 
-                    delete(current_operation);
+    for(int i = 0; i < count; i++) {
 
-                }
+        apply(*ops[i], tid);
 
-                // perrform dequeue
-                else if(current_operation->dequeue) {
+    }
 
-                    // Checking if there are contents in the queue
-                    if(!(!head || !tail)) {
+}
 
-                        if(head == tail) {
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Two_lock_queue class
+ *
+ * @details
+ *  Starts the queue with head and tail on a dummy node
+ *
+ * @note
+ *  none
+ *
+ * @param[in] head_lock_type
+ *  Lock algorithm the dequeuers serialize on
+ *
+ * @param[in] tail_lock_type
+ *  Lock algorithm the enqueuers serialize on
+ *
+ ******************************************************************************/
+Two_lock_queue::Two_lock_queue(int number_of_threads, string head_lock_type, string tail_lock_type) : head_lock(head_lock_type), tail_lock(tail_lock_type), pool(number_of_threads) {
 
-                            int value = head->val;
-                            head = NULL;
-                            tail = NULL;
+    tlq_node* dummy = pool.allocate(0);
+    dummy->next.store(NULL, RELAXED);
+    head = dummy;
+    tail = dummy;
 
-                        }
-                        else {
+}
 
-                            lq_node* temp = head;
-                            head = head->next;
-                            int value = temp->val;
-                            delete(temp);
+/***************************************************************************//**
+ * @brief
+ *  Enqueues a value under the tail lock
+ *
+ * @details
+ *  The node is allocated and filled in before the lock is taken, so the critical section is just
+ *  the two pointer writes. Publishing next is what makes the value visible to dequeuers.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] val
+ *  Value of the new tlq_node
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void Two_lock_queue::enqueue(int val, int tid) {
 
-                        }
+    tlq_node* node = pool.allocate(tid);
+    node->val = val;
+    node->next.store(NULL, RELAXED);
 
-                    }
+    tail_lock.acquire();
 
-                    delete(current_operation);
+    tail->next.store(node, RELEASE);
+    tail = node;
 
-                }
+    tail_lock.release();
 
-            }
+}
 
-        }
+/***************************************************************************//**
+ * @brief
+ *  Dequeues a value under the head lock
+ *
+ * @details
+ *  The node after the dummy holds the value and becomes the new dummy. The old dummy goes back to
+ *  the pool once the lock is released. No enqueuer can still be using it, since an enqueuer is done
+ *  with a node as soon as it has published that node's next.
+ *
+ * @note
+ *  Function will return -1 if queue is empty
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+int Two_lock_queue::dequeue(int tid) {
 
-    }
+    head_lock.acquire();
 
-    // Performing lock holder's operation
+    tlq_node* dummy = head;
+    tlq_node* new_dummy = dummy->next.load(ACQ);
 
-    // Queue is not empty
-    if(!(!head || !tail)) {
+    if(new_dummy == NULL) {
 
-        if(head == tail) {
+        head_lock.release();
 
-            int value = head->val;
-            delete(head);
-            head = NULL;
-            tail = NULL;
-            lock->release();
-            return value;
+        return -1;
 
-        }
-        else {
+    }
 
-            lq_node* temp = head;
-            head = head->next;
-            int value = temp->val;
-            delete(temp);
-            lock->release();
-            return value;
+    int value = new_dummy->val;
+    head = new_dummy;
 
-        }
+    head_lock.release();
 
-    }
+    pool.release(tid, dummy);
 
-    // Queue is empty
-    else {
+    return value;
 
-        lock->release();
-        return -1;
+}
 
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Unrolled_queue class
+ *
+ * @details
+ *  Starts the queue empty, without a spare chunk
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Unrolled_queue::Unrolled_queue(int number_of_threads) : pool(number_of_threads) {
 
-    }
+    head = NULL;
+    tail = NULL;
+    spare = NULL;
 
-    lock->release();
+}
 
-    #else
+/***************************************************************************//**
+ * @brief
+ *  Enqueues a value at the end of the tail chunk
+ *
+ * @details
+ *  A new chunk is only linked in when the tail chunk is full, taken from the spare if there is one
+ *
+ * @note
+ *  Only call while holding the queue's lock
+ *
+ * @param[in] val
+ *  Value to enqueue
+ *
+ * @param[in] tid
+ *  Thread whose pool magazine supplies a new chunk
+ *
+ ******************************************************************************/
+void Unrolled_queue::enqueue(int val, int tid) {
 
-    lock->acquire();
+    if(tail == NULL || tail->end == LQ_CHUNK_VALUES) {
 
-    // Checking if there are contents in the queue
-    if(!(!head || !tail)) {
+        lq_chunk* chunk = spare;
+        spare = NULL;
 
-        if(head == tail) {
+        if(chunk == NULL) {
 
-            int value = head->val;
-            delete(head);
-            head = NULL;
-            tail = NULL;
-            lock->release();
-            return value;
+            chunk = pool.allocate(tid);
 
         }
-        else {
 
-            lq_node* temp = head;
-            head = head->next;
-            int value = temp->val;
-            delete(temp);
-            lock->release();
-            return value;
+        chunk->next = NULL;
+        chunk->begin = 0;
+        chunk->end = 0;
+
+        if(tail == NULL) {
+
+            head = chunk;
 
         }
 
-    }
+        else {
 
-    // Queue is empty
-    else {
+            tail->next = chunk;
 
-        lock->release();
-        return -1;
+        }
 
+        tail = chunk;
 
     }
 
-    lock->release();
-
-    #endif
+    tail->vals[tail->end] = val;
+    tail->end++;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is the enqueue method for the SGL_Queue class
+ *  Dequeues the value at the beginning of the head chunk
  *
  * @details
- *  Places new sgLQ_node in the queue. Flat combining optimization makes it so lock holder
- *  performs all the operartions in the array. Non lock holders, place their operations in the array. Every thread contends on lock after 
- *  placing operation in the array. 
+ *  A fully dequeued chunk is unlinked and kept as the spare, the previous spare goes back to the
+ *  pool. The last chunk is never unlinked, it just starts over once it has been emptied.
  *
  * @note
- * 	none
+ *  Only call while holding the queue's lock. Returns -1 if the queue is empty
  *
- * @param[in] val
- *  Value of the new lq_node
+ * @param[in] tid
+ *  Thread whose pool magazine takes a released chunk
  *
  ******************************************************************************/
-void SGL_Queue::enqueue(int val, Locks* lock, int tid) {
+int Unrolled_queue::dequeue(int tid) {
+
+    // Queue is empty
+    if(head == NULL || head->begin == head->end) {
 
-    lq_node *new_lq_node;
-    new_lq_node = new lq_node;
-    new_lq_node->val = val;
-    new_lq_node->next = NULL;
+        return -1;
+
+    }
+
+    int value = head->vals[head->begin];
+    head->begin++;
+
+    if(head->begin == head->end) {
+
+        if(head == tail) {
 
-    #ifdef FLAT_COMBINING_OPTIMIZATION_ON
+            head->begin = 0;
+            head->end = 0;
 
-    // Non lock holder
-    while(lock->try_acquire() == EBUSY) {
+        }
 
-        // Not lock holder, so place operation into combining array
-        sglQ_operations* operation = new sglQ_operations;
-        operation->dequeue = false;
-        operation->enqueue = true;
-        operation->enqueue_value = val;
+        else if(head->begin == LQ_CHUNK_VALUES) {
 
-        while(true) {
+            lq_chunk* emptied = head;
+            head = emptied->next;
 
-            sglQ_operations* current_index = flat_combining_array[tid].load(ACQ);
-            if(flat_combining_array[tid].compare_exchange_strong(current_index,operation,ACQREL)) {
+            if(spare != NULL) {
 
-                while(lock->try_acquire() == EBUSY) {}
-                break;
+                pool.release(tid, spare);
 
             }
 
-        }
+            spare = emptied;
 
-        break;
+        }
 
     }
 
-    for(int i = 0; i < NUM_THREADS; i++) {
+    return value;
 
-        sglQ_operations* current_operation = flat_combining_array[i].load(ACQ);
+}
 
-        if(current_operation != NULL) {
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the SGL_Queue class
+ *
+ * @details
+ *  Initialize the state of the variant being built. The base and flat combining variants get the node pool and the
+ *  sequential queue, and the flat combining variant also the flat combiner. The two lock and unrolled variants only get
+ *  the two lock queue and the unrolled queue.
+ *
+ * @note
+ *  Only the two lock variant uses the lock types, the other variants share the lock they are passed
+ *
+ * @param[in] head_lock_type
+ *  Lock algorithm of the two lock queue's head
+ *
+ * @param[in] tail_lock_type
+ *  Lock algorithm of the two lock queue's tail
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+SGL_Queue<V>::SGL_Queue(int number_of_threads, string head_lock_type, string tail_lock_type) : pool(number_of_threads), queue(&pool), combiner(&queue, number_of_threads), two_lock(number_of_threads, head_lock_type, tail_lock_type), chunks(number_of_threads) {
 
-            // Making sure no other thread has changed the operation. Make index NULL. 
-            if(flat_combining_array[i].compare_exchange_strong(current_operation,NULL)) {
+}
 
-                if(current_operation->enqueue) {
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the SGL_Queue class
+ *
+ * @details
+ *  Nodes left in the queue are freed along with the node pool
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+SGL_Queue<V>::~SGL_Queue() {
 
-                    if(!head || !tail) {
+}
 
-                        head = new_lq_node;
-                        tail = new_lq_node;
+/***************************************************************************//**
+ * @brief
+ *  This is the dequeue method for the SGL_Queue class
+ *
+ * @details
+ *  Function dequeues and returns the value of the dequeued lq_node. Flat combining optimization publishes the dequeue to the
+ *  flat combiner, where whichever thread holds the lock performs every published operation. The two lock variant ignores
+ *  the global lock and only serializes against other dequeuers. The unrolled variant dequeues from an array chunk under
+ *  the lock, which rarely frees anything.
+ *
+ * @note
+ * 	Function will return -1 if queue is empty
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+int SGL_Queue<V>::dequeue(Locks* lock, int tid) {
 
-                    }
+    // Separate head and tail locks
+    if constexpr(V == two_lock_variant) {
 
-                    else {
+        return two_lock.dequeue(tid);
 
-                        tail->next = new_lq_node;
-                        tail = new_lq_node;
+    }
 
-                    }
+    // Unrolled array chunks
+    else if constexpr(V == unrolled_variant) {
 
-                    delete(current_operation);
+        lock->acquire();
 
-                }
+        int value = chunks.dequeue(tid);
+        lock->release();
 
-                else if(current_operation->dequeue) {
+        return value;
 
-                    // Checking if there are contents in the queue
-                    if(!(!head || !tail)) {
+    }
 
-                        if(head == tail) {
+    // Flat combining optimization
+    else if constexpr(V == flat_combining_variant) {
 
-                            int value = head->val;
-                            head = NULL;
-                            tail = NULL;
+        lq_operation operation;
+        operation.enqueue = false;
 
-                        }
-                        else {
+        combiner.apply(operation, lock, tid);
 
-                            lq_node* temp = head;
-                            head = head->next;
-                            int value = temp->val;
-                            delete(temp);
+        return operation.value;
 
-                        }
+    }
 
-                    }
-                    delete(current_operation);
+    // No optimization
+    else {
 
-                }
+        lock->acquire();
 
-            }
+        int value = queue.dequeue(tid);
+        lock->release();
 
-        }
+        return value;
 
     }
 
-    // Performing lock holder's operation
+}
 
-    if(!head || !tail) {
+/***************************************************************************//**
+ * @brief
+ *  This is the enqueue method for the SGL_Queue class
+ *
+ * @details
+ *  Places new lq_node in the queue. Flat combining optimization publishes the enqueue to the flat combiner, where
+ *  whichever thread holds the lock performs every published operation. The two lock variant ignores the global lock and
+ *  only serializes against other enqueuers. The unrolled variant enqueues into an array chunk under the lock and only
+ *  allocates when the chunk is full.
+ *
+ * @note
+ * 	none
+ *
+ * @param[in] val
+ *  Value of the new lq_node
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+void SGL_Queue<V>::enqueue(int val, Locks* lock, int tid) {
+
+    // Separate head and tail locks
+    if constexpr(V == two_lock_variant) {
 
-        head = new_lq_node;
-        tail = new_lq_node;
+        two_lock.enqueue(val, tid);
+
+        return;
 
     }
 
-    else {
+    // Unrolled array chunks
+    else if constexpr(V == unrolled_variant) {
 
-        tail->next = new_lq_node;
-        tail = new_lq_node;
+        lock->acquire();
 
-    }
+        chunks.enqueue(val, tid);
+        lock->release();
 
-    lock->release();
+        return;
 
-    return;
+    }
 
-    #else
+    // Flat combining optimization
+    else if constexpr(V == flat_combining_variant) {
 
-    lock->acquire();
+        lq_operation operation;
+        operation.enqueue = true;
+        operation.value = val;
 
-    if(!head || !tail) {
+        combiner.apply(operation, lock, tid);
 
-        head = new_lq_node;
-        tail = new_lq_node;
+        return;
 
     }
 
+    // No optimization
     else {
 
-        tail->next = new_lq_node;
-        tail = new_lq_node;
+        lq_node* new_lq_node = pool.allocate(tid);
+        new_lq_node->val = val;
 
-    }
+        lock->acquire();
 
-    lock->release();
+        queue.enqueue_node(new_lq_node);
+        lock->release();
 
-    #endif
+    }
 
 }
+
+// Variants of the SGL queue
+template class SGL_Queue<base_variant>;
+template class SGL_Queue<flat_combining_variant>;
+template class SGL_Queue<two_lock_variant>;
+template class SGL_Queue<unrolled_variant>;
@@ -13,19 +13,28 @@
 
 #include <iostream>
 #include <atomic>
+#include <string>
 #include "Locks.hpp"
+#include "Node_Pool.hpp"
+#include "Flat_Combiner.hpp"
+#include "Optimization_Variant.hpp"
 
 //***********************************************************************************
 // defined files
 //***********************************************************************************
 using std::atomic;
+using std::string;
 using std::cout;
 using std::endl;
 
 #define ACQREL std::memory_order_acq_rel
 #define ACQ std::memory_order_acquire
+#define RELEASE std::memory_order_release
+#define RELAXED std::memory_order_relaxed
 
-#define FLAT_COMBINING_OPTIMIZATION_ON
+// Each unrolled chunk fills a whole number of cache lines
+#define UNROLLED_CHUNK_BYTES (4 * CACHE_LINE_SIZE)
+#define LQ_CHUNK_VALUES ((UNROLLED_CHUNK_BYTES - sizeof(void*) - 2 * sizeof(int)) / sizeof(int))
 
 //***********************************************************************************
 // data structure prototypes
@@ -37,31 +46,108 @@ struct lq_node {
 
 };
 
-struct sglQ_operations {
+// An enqueue carries its value in, a dequeue carries its value (or -1 when empty) back out
+struct lq_operation {
 
-    bool dequeue;
     bool enqueue;
-    int enqueue_value;
+    int value;
 
 };
 
-class SGL_Queue {
+// The queue itself without any synchronization, only touched while the lock is held
+class Seq_queue {
 
     private:
-    Locks* lock;
     lq_node* head;
     lq_node* tail;
-    atomic<sglQ_operations*>* flat_combining_array;
-    int NUM_THREADS;
+    Node_Pool<lq_node>* pool;
+
+    public:
+    typedef lq_operation operation;
+    Seq_queue(Node_Pool<lq_node>* node_pool);
+    void enqueue_node(lq_node* node);
+    int dequeue(int tid);
+    void apply(lq_operation& op, int tid);
+    void apply_batch(lq_operation** ops, int count, int tid);
+
+};
+
+// A dequeuer reads next of the dummy while an enqueuer may be writing it, so next is atomic
+struct tlq_node {
+
+    int val;
+    atomic<tlq_node*> next;
+
+};
+
+// Michael and Scott's two lock queue. Head always points at a dummy node, so enqueuers only touch
+// the tail and dequeuers only touch the head, each side under its own lock on its own cache line.
+class Two_lock_queue {
+
+    private:
+    alignas(CACHE_LINE_SIZE) Locks head_lock;
+    tlq_node* head;
+    alignas(CACHE_LINE_SIZE) Locks tail_lock;
+    tlq_node* tail;
+    alignas(CACHE_LINE_SIZE) Node_Pool<tlq_node> pool;
+
+    public:
+    Two_lock_queue(int number_of_threads, string head_lock_type, string tail_lock_type);
+    void enqueue(int val, int tid);
+    int dequeue(int tid);
+
+};
+
+// An unrolled queue node, values are enqueued at end and dequeued from begin
+struct alignas(CACHE_LINE_SIZE) lq_chunk {
+
+    lq_chunk* next;
+    int begin;
+    int end;
+    int vals[LQ_CHUNK_VALUES];
+
+};
+
+static_assert(sizeof(lq_chunk) == UNROLLED_CHUNK_BYTES, "An lq_chunk fills its cache lines");
+
+// Unrolled queue without any synchronization, only touched while the lock is held. The allocator is
+// only used when the tail chunk fills or the head chunk empties, and the last emptied chunk is kept
+// as a spare for the next chunk the tail needs.
+class Unrolled_queue {
+
+    private:
+    lq_chunk* head;
+    lq_chunk* tail;
+    lq_chunk* spare;
+    Node_Pool<lq_chunk> pool;
 
     public:
-    SGL_Queue(int number_of_threads);
+    Unrolled_queue(int number_of_threads);
+    void enqueue(int val, int tid);
+    int dequeue(int tid);
+
+};
+
+// Built as base_variant, flat_combining_variant, two_lock_variant and unrolled_variant
+template<optimization_variant V>
+class SGL_Queue {
+
+    static_assert(V != elimination_variant, "The SGL queue has no elimination variant");
+
+    private:
+    Locks* lock;
+    variant_state<V == base_variant || V == flat_combining_variant, Node_Pool<lq_node> > pool;
+    variant_state<V == base_variant || V == flat_combining_variant, Seq_queue> queue;
+    variant_state<V == flat_combining_variant, Flat_Combiner<Seq_queue> > combiner;
+    variant_state<V == two_lock_variant, Two_lock_queue> two_lock;
+    variant_state<V == unrolled_variant, Unrolled_queue> chunks;
+
+    public:
+    SGL_Queue(int number_of_threads, string head_lock_type = "pthread", string tail_lock_type = "pthread");
     ~SGL_Queue();
     void enqueue(int val, Locks* lock, int tid);
     int dequeue(Locks* lock, int tid);
 
-
-
 };
 
 #endif
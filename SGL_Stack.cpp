@@ -17,513 +17,515 @@
 
 /***************************************************************************//**
  * @brief
- *  This is the constructor for the SGL_Stack Class
+ *  This is the constructor for the Seq_stack class
  *
  * @details
- *  Initialize the global lock  and top ls_node. If flat combining optimization is turned on,
- *  initialize the flat combining array. If elimination opimizaation is turned on, initialize
- *  the eliminations array. 
+ *  Starts the stack empty
  *
  * @note
- * none
+ *  none
+ *
+ * @param[in] node_pool
+ *  Pool the stack allocates and frees its nodes through
  *
  ******************************************************************************/
-SGL_stack::SGL_stack(int number_of_threads, int iterations) {
-
-    ls_node* initialized_ls_node = NULL;
-    top = initialized_ls_node;
-
-    #ifdef ELIMINATION_OPTIMIZATION_ON
-
-    ELIM_ARRAY_SIZE = (number_of_threads * iterations)/2;
-    elimination_array = new atomic<sglS_operations*>[ELIM_ARRAY_SIZE];
-
-    for(int i = 0; i < ELIM_ARRAY_SIZE; i++) {
-
-        elimination_array[i].store(NULL);
-
-    }
-
-    #endif
-
-    #ifdef FLAT_COMBINING_OPTIMIZATION_ON
-
-    NUM_THREADS = number_of_threads;
-    flat_combining_array = new atomic<sglS_operations*>[number_of_threads];
+Seq_stack::Seq_stack(Node_Pool<ls_node>* node_pool) {
 
-    for(int i = 0; i < number_of_threads; i++) {
-
-        flat_combining_array[i].store(NULL);
-
-    }
-
-    #endif
+    top = NULL;
+    pool = node_pool;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is the destructor for the SGL_Stack class
+ *  Pushes an already allocated ls_node
  *
  * @details
- *  Deletes the flat combining array if it was created. Deletes the eliminations array 
- *  if it was created
+ *  none
  *
  * @note
- *  none
+ *  Only call while holding the stack's lock
+ *
+ * @param[in] node
+ *  Node holding the pushed value
  *
  ******************************************************************************/
-SGL_stack::~SGL_stack() {
-
-    top = NULL;
-
-    #ifdef ELIMINATION_OPTIMIZATION_ON
-
-    delete [] elimination_array;
-
-    #endif
+void Seq_stack::push_node(ls_node* node) {
 
-    #ifdef FLAT_COMBINING_OPTIMIZATION_ON
-
-    delete [] flat_combining_array;
-
-    #endif
+    node->next = top;
+    top = node;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is a time delay function. 
+ *  Pops the top ls_node and returns its value
  *
  * @details
- *  none
+ *  The popped node goes straight back to the pool
  *
  * @note
- * 	none
+ *  Only call while holding the stack's lock. Returns -1 if the stack is empty
  *
- * @param[in] milliseconds
- *  Length of delay in milliseconds
+ * @param[in] tid
+ *  Thread whose pool magazine takes the node
  *
  ******************************************************************************/
-static void time_delay(int milliseconds) {
+int Seq_stack::pop(int tid) {
+
+    if(top == NULL) {
+
+        return -1;
+
+    }
 
-    clock_t start_time = clock();
+    ls_node* temp = top;
+    top = temp->next;
+    int value = temp->val;
+    pool->release(tid, temp);
 
-    while(clock() < start_time + milliseconds) {};
+    return value;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is the pop method for the SGL_Stack class
+ *  Performs a published operation for the flat combiner
  *
  * @details
- *  Function pops the top of the stack and returns the value of the popped ls_node. Flat combining optimization makes it so lock holder
- *  performs all the operartions in the array. Non lock holders, place their operations in the array. Every thread contends on lock after 
- *  placing operation in the array. Elimination optimization is similar in that it also relievevs contention on the global lock. The lock holder
- *  performs their operation and returns, non lock holders pick a random index in the elimination array and see what;s in the index. If the 
- *  complimentary operation is in the index, then the thread will perform both operations and return. If the index is NULL, then the operation will
- *  place its operation in the index and wait for some delay. It then checks if its operation was commpleted by another thread. If not,
- *  it then contends on lock again. The process is repeated if the thread doesn't acquire the lock. 
- *  
- *  
+ *  A pop leaves the popped value in the operation
  *
  * @note
- * 	Function will return -1 if stack is empty
+ *  Only call while holding the stack's lock
+ *
+ * @param[in] op
+ *  Operation to perform
+ *
+ * @param[in] tid
+ *  Combining thread
  *
  ******************************************************************************/
-int SGL_stack::pop(Locks* lock, int tid) {
-
-    int value;
-
-    while(true) {
-
-        // Elimination optimization turned on
-        #ifdef ELIMINATION_OPTIMIZATION_ON
-
-
-        while(lock->try_acquire() == EBUSY) {
-            
-            int index = rand() % ELIM_ARRAY_SIZE;
-            sglS_operations* elimination_index = elimination_array[index].load(ACQ);
+void Seq_stack::apply(ls_operation& op, int tid) {
 
-            // Empty slot in elimination array
-            if(elimination_index == NULL) {
+    if(op.push) {
 
-                sglS_operations* operation = new sglS_operations;
-                operation->pop = true;
-                operation->push = false;
+        ls_node* node = pool->allocate(tid);
+        node->val = op.value;
+        push_node(node);
 
-                // Place operation into array
-                if(elimination_array[index].compare_exchange_strong(elimination_index, operation, ACQREL)) {
-
-                    // Figure out how long to delay
-                    time_delay(DELAY);
-                    sglS_operations* temp = elimination_array[index].load(ACQ);
-
-                    // No one combined while waiting
-                    if(temp != NULL) {
+    }
 
-                        // Take operation out and try again on stack
-                        elimination_array[index].compare_exchange_strong(temp, NULL);
+    else {
 
-                    }
+        op.value = pop(tid);
 
-                }
+    }
 
-            }
+}
 
-            // Slot has a push operation
-            else if(elimination_index->push) {
+/***************************************************************************//**
+ * @brief
+ *  Performs one combining pass for the flat combiner
+ *
+ * @details
+ *  Every operation in the pass is concurrent, so a push and a pop can be ordered back to back
+ *  and the pop handed the pushed value without touching the list. Pushes and pops are paired
+ *  off first and only the surplus of one kind is applied to the list, so a balanced pass
+ *  never allocates or frees a node.
+ *
+ * @note
+ *  Only called by the combiner while it holds the stack's lock
+ *
+ * @param[in] ops
+ *  Operations published for this pass
+ *
+ * @param[in] count
+ *  Number of operations
+ *
+ * @param[in] tid
+ *  Combining thread
+ *
+ ******************************************************************************/
+void Seq_stack::apply_batch(ls_operation** ops, int count, int tid) {
 
-                // Perform matching operations and remove operation from elimination array
-                if(elimination_array[index].compare_exchange_strong(elimination_index, NULL, ACQREL)) {
+    int next_push = 0;
+    int next_pop = 0;
 
-                    int return_value = elimination_index->push_value;
-        
-                    delete(elimination_index);
-                    return return_value;
+    while(true) {
 
-                }
+        while(next_push < count && !ops[next_push]->push) {
 
-            }
+            next_push++;
 
         }
 
-        if(top != NULL) {
-
-            ls_node* temp = top;
-            top = temp->next;
-            int value = temp->val;
-            delete(temp);
+        while(next_pop < count && ops[next_pop]->push) {
 
-            lock->release();
+            next_pop++;
 
-            return value;
         }
 
-        else {
+        if(next_push == count || next_pop == count) {
 
-            lock->release();
-            return -1;
+            break;
 
         }
 
-        #endif
-
+        ops[next_pop]->value = ops[next_push]->value;
+        next_push++;
+        next_pop++;
 
-        #ifdef FLAT_COMBINING_OPTIMIZATION_ON
+    }
 
-        // Non lock holder
-        while(lock->try_acquire() == EBUSY) {
+    // Only one kind of operation is left unmatched
+    for(int i = next_push; i < count; i++) {
 
-            // Not lock holder, so place operationinto combining array
-            sglS_operations* operation = new sglS_operations;
-            operation->pop = true;
-            operation->push = false;
+        if(ops[i]->push) {
 
-            while(true) {
+            apply(*ops[i], tid);
 
-                sglS_operations* current_index = flat_combining_array[tid].load(ACQ);
-                if(flat_combining_array[tid].compare_exchange_strong(current_index,operation,ACQREL)) {
+        }
 
-                    while(lock->try_acquire() == EBUSY) {}
-                    break;
+    }
 
-                }
+    for(int i = next_pop; i < count; i++) {
 
-            }
+        if(!ops[i]->push) {
 
-            break;
+            apply(*ops[i], tid);
 
         }
 
-        // lock holder
-        
-        for(int i = 0; i < NUM_THREADS; i++) {
-
-            sglS_operations* current_operation = flat_combining_array[i].load(ACQ);
+    }
 
-            if(current_operation != NULL) {
+}
 
-                if(flat_combining_array[i].compare_exchange_strong(current_operation,NULL)) {
-                    
-                    
-                    if(current_operation->push) {
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Unrolled_stack class
+ *
+ * @details
+ *  Starts the stack empty, without a spare chunk
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Unrolled_stack::Unrolled_stack(int number_of_threads) : pool(number_of_threads) {
 
-                        ls_node* updated_top = new ls_node;
-                        updated_top->val = current_operation->push_value;
-                        updated_top->next = top;
-                        top = updated_top;
+    top = NULL;
+    spare = NULL;
 
-                        delete(current_operation);
+}
 
-                    }
+/***************************************************************************//**
+ * @brief
+ *  Pushes a value into the top chunk
+ *
+ * @details
+ *  A new chunk is only linked in when the top chunk is full, taken from the spare if there is one
+ *
+ * @note
+ *  Only call while holding the stack's lock
+ *
+ * @param[in] val
+ *  Value to push
+ *
+ * @param[in] tid
+ *  Thread whose pool magazine supplies a new chunk
+ *
+ ******************************************************************************/
+void Unrolled_stack::push(int val, int tid) {
 
-                    else if(current_operation->pop) {
+    if(top == NULL || top->count == LS_CHUNK_VALUES) {
 
-                        if(top != NULL) {
+        ls_chunk* chunk = spare;
+        spare = NULL;
 
-                            ls_node* temp = top;
+        if(chunk == NULL) {
 
-                            int value = temp->val;
+            chunk = pool.allocate(tid);
 
-                            top = temp->next;
+        }
 
-                            delete(temp);
+        chunk->count = 0;
+        chunk->next = top;
+        top = chunk;
 
-                        }
+    }
 
-                        delete(current_operation);
+    top->vals[top->count] = val;
+    top->count++;
 
-                    }   
+}
 
-                    
-                }
+/***************************************************************************//**
+ * @brief
+ *  Pops the last value of the top chunk
+ *
+ * @details
+ *  An emptied chunk is unlinked and kept as the spare, the previous spare goes back to the pool
+ *
+ * @note
+ *  Only call while holding the stack's lock. Returns -1 if the stack is empty
+ *
+ * @param[in] tid
+ *  Thread whose pool magazine takes a released chunk
+ *
+ ******************************************************************************/
+int Unrolled_stack::pop(int tid) {
 
-            }
+    if(top == NULL) {
 
-        }
+        return -1;
 
-        if(top != NULL) {
+    }
 
-            ls_node* temp = top;
-            top = temp->next;
-            int value = temp->val;
-            delete(temp);
+    top->count--;
+    int value = top->vals[top->count];
 
-            lock->release();
+    if(top->count == 0) {
 
-            return value;
-        }
+        ls_chunk* emptied = top;
+        top = emptied->next;
 
-        else {
+        if(spare != NULL) {
 
-            lock->release();
-            return -1;
+            pool.release(tid, spare);
 
         }
 
-        #endif
-
-
-        // Elimination optimization turned off
-        #ifdef NO_OPTIMIZATION
-
-        lock->acquire();
+        spare = emptied;
 
-        if(top != NULL) {
+    }
 
-            ls_node* temp = top;
-            top = temp->next;
-            int value = temp->val;
-            delete(temp);
+    return value;
 
-            lock->release();
+}
 
-            return value;
-        }
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the SGL_Stack Class
+ *
+ * @details
+ *  Initialize the node pool and the sequential stack, or the unrolled stack for the unrolled variant. Only the
+ *  elimination variant builds an elimination array and only the flat combining variant builds a flat combiner.
+ *
+ * @note
+ * none
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+SGL_stack<V>::SGL_stack(int number_of_threads) : pool(number_of_threads), stack(&pool), elimination(number_of_threads), combiner(&stack, number_of_threads), chunks(number_of_threads) {
 
-        else {
+}
 
-            lock->release();
-            return -1;
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the SGL_Stack class
+ *
+ * @details
+ *  Nodes left on the stack are freed along with the node pool
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+SGL_stack<V>::~SGL_stack() {
 
-        }
+}
 
-        #endif
+/***************************************************************************//**
+ * @brief
+ *  Returns the stack's elimination array
+ *
+ * @details
+ *  Used to report how many operations were eliminated
+ *
+ * @note
+ *  NULL unless this is the elimination variant
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+Elimination_Array* SGL_stack<V>::elimination_array() {
 
-    }   
+    if constexpr(V == elimination_variant) {
+        return &elimination;
+    }
 
+    return NULL;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is the push method for the SGL_Stack class
+ *  This is the pop method for the SGL_Stack class
  *
  * @details
- *  Pushes a new ls_node to the top of the stack.Flat combining optimization makes it so lock holder
- *  performs all the operartions in the array. Non lock holders, place their operations in the array. Every thread contends on lock after 
- *  placing operation in the array. Elimination optimization is similar in that it also relievevs contention on the global lock. The lock holder
- *  performs their operation and returns, non lock holders pick a random index in the elimination array and see what;s in the index. If the 
- *  complimentary operation is in the index, then the thread will perform both operations and return. If the index is NULL, then the operation will
- *  place its operation in the index and wait for some delay. It then checks if its operation was commpleted by another thread. If not,
- *  it then contends on lock again. The process is repeated if the thread doesn't acquire the lock. 
+ *  Function pops the top of the stack and returns the value of the popped ls_node. Flat combining optimization publishes the pop
+ *  to the flat combiner, where whichever thread holds the lock performs every published operation. Elimination optimization also
+ *  relieves contention on the global lock. The lock holder performs their operation and returns, non lock holders try the
+ *  elimination array. A pop takes the node of a waiting push, or waits briefly in a slot for one to show up. If no partner was
+ *  found the thread tries the lock again. The process is repeated if the thread doesn't acquire the lock. The unrolled variant
+ *  pops from an array chunk under the lock, which rarely frees anything.
  *
  * @note
- * 	none
- *
- * @param[in] val
- *  Value of the new top ls_node
+ * 	Function will return -1 if stack is empty
  *
  ******************************************************************************/
-void SGL_stack::push(int val, Locks* lock, int tid) {
-
-    
-    ls_node* new_top = new ls_node;
-    new_top->val = val;
-
-    // Elimination optimization turned on
-    #ifdef ELIMINATION_OPTIMIZATION_ON
+template<optimization_variant V>
+int SGL_stack<V>::pop(Locks* lock, int tid) {
 
-    while(lock->try_acquire() == EBUSY) {
-        
-        int index = rand() % ELIM_ARRAY_SIZE;
-        sglS_operations* elimination_index = elimination_array[index].load(ACQ);
+    // Unrolled array chunks
+    if constexpr(V == unrolled_variant) {
 
-        // Empty slot in elimination array
-        if(elimination_index == NULL) {
-
-            sglS_operations* operation = new sglS_operations;
-            operation->pop = false;
-            operation->push = true;
-            operation->push_value = val;
+        lock->acquire();
 
-            // Place operation into array
-            if(elimination_array[index].compare_exchange_strong(elimination_index, operation, ACQREL)) {
+        int value = chunks.pop(tid);
+        lock->release();
 
-                // Figure out how long to delay
-                time_delay(DELAY);
-                sglS_operations* temp = elimination_array[index].load(ACQ);
+        return value;
 
-                // No one combined while waiting
-                if(temp != NULL) {
+    }
 
-                    // Take operation out and try again on stack
-                    elimination_array[index].compare_exchange_strong(temp, NULL);
+    // Single lock stack
+    else {
 
-                }
+        // Elimination optimization
+        if constexpr(V == elimination_variant) {
 
-            }
+            while(lock->try_acquire() == EBUSY) {
 
-        }
+                ls_node* eliminated = (ls_node*)elimination.exchange_pop(tid);
 
-        // Slot has a push operation
-        else if(elimination_index->pop) {
+                // Took the node of a push that never reached the stack
+                if(eliminated != NULL) {
 
-            // Perform matching operations and remove operation from elimination array
-            if(elimination_array[index].compare_exchange_strong(elimination_index, NULL, ACQREL)) {
+                    int return_value = eliminated->val;
+                    pool.release(tid, eliminated);
 
-                int return_value = elimination_index->push_value;
+                    return return_value;
 
-                delete(elimination_index);
-                delete(new_top);
-                return;
+                }
 
             }
 
         }
 
-    }
-
-    new_top->next = top;
-    top = new_top;
+        // Flat combining optimization
+        else if constexpr(V == flat_combining_variant) {
 
-    lock->release();
+            ls_operation operation;
+            operation.push = false;
 
-    return;
+            combiner.apply(operation, lock, tid);
 
-    #endif
+            return operation.value;
 
+        }
 
-    #ifdef FLAT_COMBINING_OPTIMIZATION_ON
-
-    // Non lock holder
-    while(lock->try_acquire() == EBUSY) {
-
-        // Not lock holder, so place operationinto combining array
-        sglS_operations* operation = new sglS_operations;
-        operation->pop = false;
-        operation->push = true;
-        operation->push_value = val;
-
-        while(true) {
-
-            sglS_operations* current_index = flat_combining_array[tid].load(ACQ);
-            if(flat_combining_array[tid].compare_exchange_strong(current_index,operation,ACQREL)) {
-
-                while(lock->try_acquire() == EBUSY) {}
-                break;
+        // No optimization
+        else {
 
-            }
+            lock->acquire();
 
         }
 
-        break;
+        int value = stack.pop(tid);
+        lock->release();
+
+        return value;
 
     }
 
-    for(int i = 0; i < NUM_THREADS; i++) {
+}
 
-        sglS_operations* current_operation = flat_combining_array[i].load(ACQ);
+/***************************************************************************//**
+ * @brief
+ *  This is the push method for the SGL_Stack class
+ *
+ * @details
+ *  Pushes a new ls_node to the top of the stack. Flat combining optimization publishes the push to the flat combiner, where
+ *  whichever thread holds the lock performs every published operation. Elimination optimization also relieves contention on the
+ *  global lock. The lock holder performs their operation and returns, non lock holders try the elimination array. A push hands
+ *  its node straight to a waiting pop, or waits briefly in a slot for one to show up. If no partner was found the thread tries
+ *  the lock again. The process is repeated if the thread doesn't acquire the lock. The unrolled variant pushes into an array
+ *  chunk under the lock and only allocates when the chunk is full.
+ *
+ * @note
+ * 	none
+ *
+ * @param[in] val
+ *  Value of the new top ls_node
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+void SGL_stack<V>::push(int val, Locks* lock, int tid) {
 
-        if(current_operation != NULL) {
+    // Unrolled array chunks
+    if constexpr(V == unrolled_variant) {
 
-            if(flat_combining_array[i].compare_exchange_strong(current_operation,NULL)) {
+        lock->acquire();
 
+        chunks.push(val, tid);
+        lock->release();
 
-                if(current_operation->push) {
+        return;
 
-                    ls_node* updated_top = new ls_node;
-                    updated_top->val = current_operation->push_value;
-                    updated_top->next = top;
-                    top = updated_top;
+    }
 
-                    delete(current_operation);
+    // Single lock stack
+    else {
 
-                }
+        // Flat combining optimization
+        if constexpr(V == flat_combining_variant) {
 
-                else if(current_operation->pop) {
+            ls_operation operation;
+            operation.push = true;
+            operation.value = val;
 
-                    if(top != NULL) {
+            combiner.apply(operation, lock, tid);
 
-                        ls_node* temp = top;
+            return;
 
-                        int value = temp->val;
+        }
 
-                        top = temp->next;
+        ls_node* new_top = pool.allocate(tid);
+        new_top->val = val;
 
-                        delete(temp);
+        // Elimination optimization
+        if constexpr(V == elimination_variant) {
 
-                    }
+            while(lock->try_acquire() == EBUSY) {
 
-                    delete(current_operation);
+                // The popping thread takes ownership of the node
+                if(elimination.exchange_push(tid, new_top)) {
 
-                }   
+                    return;
 
+                }
 
             }
 
         }
 
-    }
-
-    // ls_node* new_top = new ls_node;
-    // new_top->val = val;
-
-
-    new_top->next = top;
-
-    top = new_top;
-
-    lock->release();
-
-    return;
-
-    #endif
-
-    // Elimination and Flat Combining optimizations turned off
-    #ifdef NO_OPTIMIZATION
+        // No optimization
+        else {
 
-    lock->acquire();
+            lock->acquire();
 
-    new_top->next = top;
+        }
 
-    top = new_top;
+        stack.push_node(new_top);
+        lock->release();
 
-    lock->release();
+    }
 
-    #endif
+}
 
-}
\ No newline at end of file
+// Variants of the SGL stack
+template class SGL_stack<base_variant>;
+template class SGL_stack<elimination_variant>;
+template class SGL_stack<flat_combining_variant>;
+template class SGL_stack<unrolled_variant>;
@@ -15,6 +15,10 @@
 #include <atomic>
 #include <vector>
 #include "Locks.hpp"
+#include "Node_Pool.hpp"
+#include "Elimination_Array.hpp"
+#include "Flat_Combiner.hpp"
+#include "Optimization_Variant.hpp"
 
 //***********************************************************************************
 // defined files
@@ -23,11 +27,10 @@ using std::atomic;
 
 #define ACQREL std::memory_order_acq_rel
 #define ACQ std::memory_order_acquire
-#define DELAY 200
 
-#define ELIMINATION_OPTIMIZATION_ON
-// #define FLAT_COMBINING_OPTIMIZATION_ON
-// #define NO_OPTIMIZATION
+// Each unrolled chunk fills a whole number of cache lines
+#define UNROLLED_CHUNK_BYTES (4 * CACHE_LINE_SIZE)
+#define LS_CHUNK_VALUES ((UNROLLED_CHUNK_BYTES - sizeof(void*) - sizeof(int)) / sizeof(int))
 
 //***********************************************************************************
 // data structure prototypes
@@ -39,27 +42,77 @@ struct ls_node {
 
 };
 
-struct sglS_operations {
+// A push carries its value in, a pop carries its value (or -1 when empty) back out
+struct ls_operation {
 
-    bool pop;
     bool push;
-    int push_value;
+    int value;
 
 };
 
+// The stack itself without any synchronization, only touched while the lock is held
+class Seq_stack {
+
+    private:
+    ls_node* top;
+    Node_Pool<ls_node>* pool;
+
+    public:
+    typedef ls_operation operation;
+    Seq_stack(Node_Pool<ls_node>* node_pool);
+    void push_node(ls_node* node);
+    int pop(int tid);
+    void apply(ls_operation& op, int tid);
+    void apply_batch(ls_operation** ops, int count, int tid);
+
+};
+
+// An unrolled stack node, values are pushed and popped at the end of vals
+struct alignas(CACHE_LINE_SIZE) ls_chunk {
+
+    ls_chunk* next;
+    int count;
+    int vals[LS_CHUNK_VALUES];
+
+};
+
+static_assert(sizeof(ls_chunk) == UNROLLED_CHUNK_BYTES, "An ls_chunk fills its cache lines");
+
+// Unrolled stack without any synchronization, only touched while the lock is held. The allocator
+// is only used when the top chunk fills or empties, and the last emptied chunk is kept as a spare
+// so pushing and popping across a chunk boundary does not touch the allocator at all.
+class Unrolled_stack {
+
+    private:
+    ls_chunk* top;
+    ls_chunk* spare;
+    Node_Pool<ls_chunk> pool;
+
+    public:
+    Unrolled_stack(int number_of_threads);
+    void push(int val, int tid);
+    int pop(int tid);
+
+};
+
+// Built as base_variant, elimination_variant, flat_combining_variant and unrolled_variant
+template<optimization_variant V>
 class SGL_stack {
 
+    static_assert(V != two_lock_variant, "The SGL stack has no two lock variant");
+
     private:
     Locks* lock;
-    ls_node* top;
-    atomic<sglS_operations*>* elimination_array;
-    int ELIM_ARRAY_SIZE;
-    atomic<sglS_operations*>* flat_combining_array;
-    int NUM_THREADS;
+    variant_state<V != unrolled_variant, Node_Pool<ls_node> > pool;
+    variant_state<V != unrolled_variant, Seq_stack> stack;
+    variant_state<V == elimination_variant, Elimination_Array> elimination;
+    variant_state<V == flat_combining_variant, Flat_Combiner<Seq_stack> > combiner;
+    variant_state<V == unrolled_variant, Unrolled_stack> chunks;
 
     public:
-    SGL_stack(int number_of_threads, int iterations);
+    SGL_stack(int number_of_threads);
     ~SGL_stack();
+    Elimination_Array* elimination_array();
     void push(int val, Locks* lock, int tid);
     int pop(Locks* lock, int tid);
 
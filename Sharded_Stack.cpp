@@ -0,0 +1,313 @@
+/**
+ * @file Sharded_Stack.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for the sharded stack that steals from other shards when its own is empty
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "Sharded_Stack.hpp"
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Sharded_stack class
+ *
+ * @details
+ *  Initialize the node pool and start every shard empty
+ *
+ * @note
+ *  none
+ *
+ * @param[in] number_of_shards
+ *  Number of sub stacks
+ *
+ * @param[in] shard_choice
+ *  Whether threads pick their home shard by thread id or by CPU
+ *
+ ******************************************************************************/
+Sharded_stack::Sharded_stack(int number_of_threads, int number_of_shards, shard_selection shard_choice) : pool(number_of_threads) {
+
+    NUM_THREADS = number_of_threads;
+    NUM_SHARDS = number_of_shards > 0 ? number_of_shards : 1;
+    selection = shard_choice;
+    ibr = NULL;
+    shards = new stack_shard[NUM_SHARDS];
+    counts = new shard_counts[number_of_threads];
+
+    for(int i = 0; i < NUM_SHARDS; i++) {
+
+        shards[i].top.store(NULL, RELAXED);
+
+    }
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        counts[i].pops = 0;
+        counts[i].steals = 0;
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the Sharded_stack class
+ *
+ * @details
+ *  Nodes left in the shards are freed along with the node pool
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Sharded_stack::~Sharded_stack() {
+
+    delete [] shards;
+    delete [] counts;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Has the shards read through interval based reclamation
+ *
+ * @details
+ *  Once set, pops protect the nodes they read and new nodes are stamped with their birth era
+ *
+ * @note
+ *  Set before any thread uses the stack
+ *
+ * @param[in] interval_reclamation
+ *  Reclamation instance the popped nodes will be retired to
+ *
+ ******************************************************************************/
+void Sharded_stack::set_ibr(IBR* interval_reclamation) {
+
+    ibr = interval_reclamation;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the pool the shards allocate their nodes from
+ *
+ * @details
+ *  Popped nodes are retired with Node_Pool::reclaim and this pool as the context
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Node_Pool<tstack_node>* Sharded_stack::node_pool() {
+
+    return &pool;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns how many pops found a node
+ *
+ * @details
+ *  Sums the per thread counts
+ *
+ * @note
+ *  Only call once the threads are done
+ *
+ ******************************************************************************/
+uint64_t Sharded_stack::pops() {
+
+    uint64_t total = 0;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        total += counts[i].pops;
+
+    }
+
+    return total;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns how many pops took their node from another thread's home shard
+ *
+ * @details
+ *  Sums the per thread counts
+ *
+ * @note
+ *  Only call once the threads are done
+ *
+ ******************************************************************************/
+uint64_t Sharded_stack::steals() {
+
+    uint64_t total = 0;
+
+    for(int i = 0; i < NUM_THREADS; i++) {
+
+        total += counts[i].steals;
+
+    }
+
+    return total;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Picks the calling thread's home shard
+ *
+ * @details
+ *  CPU selection keeps threads that share a core on the same shard and follows a thread when it
+ *  migrates. Falls back to the thread id if the CPU cannot be read.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+int Sharded_stack::home_shard(int tid) {
+
+    if(selection == cpu_shard) {
+
+        int cpu = sched_getcpu();
+
+        if(cpu >= 0) {
+
+            return cpu % NUM_SHARDS;
+
+        }
+
+    }
+
+    return tid % NUM_SHARDS;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Pops the top of one shard
+ *
+ * @details
+ *  The Treiber stack pop, without elimination
+ *
+ * @note
+ * 	Function will return NULL if the shard is empty
+ *
+ * @param[in] shard
+ *  Shard to pop from
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+tstack_node* Sharded_stack::pop_shard(stack_shard* shard, int tid) {
+
+    while(true) {
+
+        tstack_node* to_pop = ibr != NULL ? ibr->protect(tid, shard->top) : shard->top.load(ACQ);
+
+        if(to_pop == NULL) {
+
+            return NULL;
+
+        }
+
+        tstack_node* new_top = to_pop->next;
+
+        if(shard->top.compare_exchange_strong(to_pop, new_top, ACQREL)) {
+
+            return to_pop;
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the pop method for the Sharded_stack class
+ *
+ * @details
+ *  Pops from the home shard. When the home shard is empty the thread steals, walking the other
+ *  shards in order starting after its own so that stealing threads spread over different victims.
+ *
+ * @note
+ * 	Function will return NULL if every shard was empty
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+tstack_node* Sharded_stack::pop(int tid) {
+
+    int home = home_shard(tid);
+
+    for(int i = 0; i < NUM_SHARDS; i++) {
+
+        tstack_node* popped = pop_shard(&shards[(home + i) % NUM_SHARDS], tid);
+
+        if(popped != NULL) {
+
+            counts[tid].pops++;
+
+            if(i > 0) {
+
+                counts[tid].steals++;
+
+            }
+
+            return popped;
+
+        }
+
+    }
+
+    return NULL;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the push method for the Sharded_stack class
+ *
+ * @details
+ *  Pushes a new tstack_node to the top of the calling thread's home shard
+ *
+ * @note
+ * 	none
+ *
+ * @param[in] val
+ *  Value of the new tstack_node
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+void Sharded_stack::push(int val, int tid) {
+
+    tstack_node* new_top = pool.allocate(tid);
+    new_top->val = val;
+    new_top->birth_era = ibr != NULL ? ibr->birth_era(tid) : 0;
+
+    stack_shard* shard = &shards[home_shard(tid)];
+    tstack_node* old_top = shard->top.load(ACQ);
+
+    do {
+
+        new_top->next = old_top;
+
+    } while(!shard->top.compare_exchange_weak(old_top, new_top, ACQREL, ACQ));
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Sharded_Stack.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef SHARDED_S_HPP
+#define SHARDED_S_HPP
+
+#include <atomic>
+#include <stdint.h>
+#include <sched.h>
+#include "IBR.hpp"
+#include "Node_Pool.hpp"
+#include "Treiber_Stack.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::atomic;
+
+#define ACQREL std::memory_order_acq_rel
+#define ACQ std::memory_order_acquire
+#define RELAXED std::memory_order_relaxed
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// How a thread picks its home shard
+enum shard_selection {
+
+    thread_shard,
+    cpu_shard
+
+};
+
+// One Treiber stack, each shard owns its cache line
+struct alignas(CACHE_LINE_SIZE) stack_shard {
+
+    atomic<tstack_node*> top;
+
+};
+
+// Per thread pop counts, only written by their owner
+struct alignas(CACHE_LINE_SIZE) shard_counts {
+
+    uint64_t pops;
+    uint64_t steals;
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  Stack split into shards that each thread mostly keeps to itself
+ *
+ * @details
+ *  Every shard is a Treiber stack. A thread pushes to and pops from its home shard, picked by
+ *  thread id or by the CPU it is running on, and only steals from the other shards once its
+ *  home shard is empty. Values come back in LIFO order per shard but not across shards, which
+ *  is all an unordered free list needs.
+ *
+ * @note
+ *  Pop returns NULL once it has seen every shard empty, values pushed meanwhile may remain
+ *
+ ******************************************************************************/
+class Sharded_stack {
+
+    private:
+    stack_shard* shards;
+    shard_counts* counts;
+    int NUM_THREADS;
+    int NUM_SHARDS;
+    shard_selection selection;
+    IBR* ibr;
+    Node_Pool<tstack_node> pool;
+    int home_shard(int tid);
+    tstack_node* pop_shard(stack_shard* shard, int tid);
+
+    public:
+    Sharded_stack(int number_of_threads, int number_of_shards, shard_selection shard_choice);
+    ~Sharded_stack();
+    void set_ibr(IBR* interval_reclamation);
+    Node_Pool<tstack_node>* node_pool();
+    uint64_t pops();
+    uint64_t steals();
+    void push(int val, int tid);
+    tstack_node* pop(int tid);
+
+};
+
+#endif
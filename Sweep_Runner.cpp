@@ -0,0 +1,253 @@
+/**
+ * @file Sweep_Runner.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for sweeping the tests over their settings
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "Sweep_Runner.hpp"
+
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+
+// Two sided 95% critical values of Student's t distribution for 1 to 30 degrees of freedom
+static const double t_critical[30] = {
+
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+
+};
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Sweep_Runner class
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  The tester must have room for the largest thread count in the sweep
+ *
+ * @param[in] base_config
+ *  Settings every point shares, the swept settings are overwritten per point
+ *
+ * @param[in] repeat
+ *  Runs kept per point
+ *
+ * @param[in] discarded
+ *  Warmup runs thrown away before them
+ *
+ * @param[in] format
+ *  csv or json
+ *
+ ******************************************************************************/
+Sweep_Runner::Sweep_Runner(DS_Tester* ds_tester, DS_Tester_config base_config, sweep_lists sweep, int repeat, int discarded, string format, FILE* out) {
+
+    tester = ds_tester;
+    base = base_config;
+    base.quiet = true;
+    lists = sweep;
+    repetitions = repeat;
+    discard = discarded;
+    json = format.compare("json") == 0;
+    output = out;
+    rows = 0;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Summarizes the values measured at one point
+ *
+ * @details
+ *  The confidence interval is mean +/- t * stddev / sqrt(n), with the normal approximation
+ *  past 30 degrees of freedom
+ *
+ * @note
+ *  A single value has no spread, its interval is just the value
+ *
+ ******************************************************************************/
+sweep_summary Sweep_Runner::summarize(vector<double> values) {
+
+    sweep_summary summary;
+    size_t n = values.size();
+
+    std::sort(values.begin(), values.end());
+
+    double sum = 0;
+
+    for(size_t i = 0; i < n; i++) {
+
+        sum += values[i];
+
+    }
+
+    summary.mean = sum / n;
+    summary.median = n % 2 == 1 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+
+    double squares = 0;
+
+    for(size_t i = 0; i < n; i++) {
+
+        squares += (values[i] - summary.mean) * (values[i] - summary.mean);
+
+    }
+
+    summary.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0.0;
+
+    double t = n > 31 ? 1.960 : n > 1 ? t_critical[n - 2] : 0.0;
+    double half_width = n > 1 ? t * summary.stddev / std::sqrt((double)n) : 0.0;
+
+    summary.ci95_low = summary.mean - half_width;
+    summary.ci95_high = summary.mean + half_width;
+
+    return summary;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Writes the row of one point
+ *
+ * @details
+ *  CSV rows follow a header written with the first row. JSON rows are objects in one array,
+ *  closed by run once the sweep is over.
+ *
+ * @note
+ *  The output is flushed after every row
+ *
+ ******************************************************************************/
+void Sweep_Runner::write_row(DS_Tester_config point, sweep_summary throughput, sweep_summary elapsed) {
+
+    if(json) {
+
+        fprintf(output, "%s\n  {\"structure\": \"%s\", \"variant\": \"%s\", \"lock\": \"%s\", \"barrier\": \"%s\", "
+            "\"threads\": %d, \"iterations\": %d, \"repetitions\": %d, "
+            "\"ops_per_sec\": {\"mean\": %.1f, \"median\": %.1f, \"stddev\": %.1f, \"ci95\": [%.1f, %.1f]}, "
+            "\"elapsed_ns\": {\"mean\": %.1f, \"median\": %.1f, \"stddev\": %.1f, \"ci95\": [%.1f, %.1f]}}",
+            rows == 0 ? "[" : ",", point.data_structure.c_str(), point.variant.c_str(), point.lock.c_str(),
+            point.barrier.c_str(), point.number_of_threads, point.iterations, repetitions,
+            throughput.mean, throughput.median, throughput.stddev, throughput.ci95_low, throughput.ci95_high,
+            elapsed.mean, elapsed.median, elapsed.stddev, elapsed.ci95_low, elapsed.ci95_high);
+
+    }
+
+    else {
+
+        if(rows == 0) {
+
+            fprintf(output, "structure,variant,lock,barrier,threads,iterations,repetitions,"
+                "ops_per_sec_mean,ops_per_sec_median,ops_per_sec_stddev,ops_per_sec_ci95_low,ops_per_sec_ci95_high,"
+                "elapsed_ns_mean,elapsed_ns_median,elapsed_ns_stddev,elapsed_ns_ci95_low,elapsed_ns_ci95_high\n");
+
+        }
+
+        fprintf(output, "%s,%s,%s,%s,%d,%d,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+            point.data_structure.c_str(), point.variant.c_str(), point.lock.c_str(), point.barrier.c_str(),
+            point.number_of_threads, point.iterations, repetitions,
+            throughput.mean, throughput.median, throughput.stddev, throughput.ci95_low, throughput.ci95_high,
+            elapsed.mean, elapsed.median, elapsed.stddev, elapsed.ci95_low, elapsed.ci95_high);
+
+    }
+
+    rows++;
+    fflush(output);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Runs the sweep
+ *
+ * @details
+ *  Thread counts vary fastest, so each scaling curve is written in one block
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+void Sweep_Runner::run() {
+
+    vector<DS_Tester_config> points;
+    DS_Tester_config point = base;
+
+    for(size_t s = 0; s < lists.structures.size(); s++) {
+
+        point.data_structure = lists.structures[s];
+
+        for(size_t v = 0; v < lists.variants.size(); v++) {
+
+            point.variant = lists.variants[v];
+
+            if(!DS_Tester::supports(point.data_structure, point.variant)) {
+
+                continue;
+
+            }
+
+            for(size_t l = 0; l < lists.locks.size(); l++) {
+
+                point.lock = lists.locks[l];
+
+                for(size_t b = 0; b < lists.barriers.size(); b++) {
+
+                    point.barrier = lists.barriers[b];
+
+                    for(size_t t = 0; t < lists.threads.size(); t++) {
+
+                        point.number_of_threads = lists.threads[t];
+                        points.push_back(point);
+
+                    }
+
+                }
+
+            }
+
+        }
+
+    }
+
+    for(size_t p = 0; p < points.size(); p++) {
+
+        vector<double> throughput;
+        vector<double> elapsed;
+
+        for(int r = 0; r < discard + repetitions; r++) {
+
+            DS_Tester_result result = tester->test(points[p]);
+
+            if(r < discard) {
+
+                continue;
+
+            }
+
+            double elapsed_ns = result.elapsed_ns > 0 ? (double)result.elapsed_ns : 1.0;
+            throughput.push_back(result.operations * 1e9 / elapsed_ns);
+            elapsed.push_back(result.elapsed_ns);
+
+        }
+
+        write_row(points[p], summarize(throughput), summarize(elapsed));
+
+    }
+
+    if(json) {
+
+        fprintf(output, rows == 0 ? "[]\n" : "\n]\n");
+        fflush(output);
+
+    }
+
+}
@@ -0,0 +1,89 @@
+/*
+ * Sweep_Runner.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef SWEEP_RUNNER_HPP
+#define SWEEP_RUNNER_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Data_Structure_Tester.hpp"
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::string;
+using std::vector;
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// Every value of each swept setting, the sweep runs every combination
+struct sweep_lists {
+
+    vector<string> structures;
+    vector<string> variants;
+    vector<string> locks;
+    vector<string> barriers;
+    vector<int> threads;
+
+};
+
+// Summary of one measurement over the kept repetitions of a point
+struct sweep_summary {
+
+    double mean;
+    double median;
+    double stddev;
+    double ci95_low;
+    double ci95_high;
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  Runs a test at every combination of structure, variant, lock, barrier and thread count
+ *
+ * @details
+ *  Each point is run a number of times on a fresh data structure. The first runs of a point
+ *  warm up the caches, allocator and CPU frequency and are discarded, the rest are summarized
+ *  by their mean, median, sample standard deviation and the 95% confidence interval of the
+ *  mean from Student's t distribution. Throughput and elapsed time are both summarized. One
+ *  row is written per point as CSV or JSON as soon as the point is done, so a long sweep can
+ *  be watched. Variants a structure does not have are skipped.
+ *
+ * @note
+ *  The tests run quietly, the rows are the sweep's only output
+ *
+ ******************************************************************************/
+class Sweep_Runner {
+
+    private:
+    DS_Tester* tester;
+    DS_Tester_config base;
+    sweep_lists lists;
+    int repetitions;
+    int discard;
+    bool json;
+    FILE* output;
+    int rows;
+    static sweep_summary summarize(vector<double> values);
+    void write_row(DS_Tester_config point, sweep_summary throughput, sweep_summary elapsed);
+
+    public:
+    Sweep_Runner(DS_Tester* ds_tester, DS_Tester_config base_config, sweep_lists sweep, int repeat, int discarded, string format, FILE* out);
+    void run();
+
+};
+
+#endif
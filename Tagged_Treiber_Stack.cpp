@@ -0,0 +1,267 @@
+/**
+ * @file Tagged_Treiber_Stack.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for the ABA safe Treiber Stack that recycles its nodes immediately
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "Tagged_Treiber_Stack.hpp"
+
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  Packs a node pointer and a tag into one word
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] node
+ *  Pointer stored in the low 48 bits
+ *
+ * @param[in] tag
+ *  Version stored in the high 16 bits
+ *
+ ******************************************************************************/
+static inline uint64_t pack(tagged_node* node, uint64_t tag) {
+
+    return ((uint64_t)node & POINTER_MASK) | (tag << TAG_SHIFT);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the node pointer held in a packed word
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] word
+ *  Packed pointer and tag
+ *
+ ******************************************************************************/
+static inline tagged_node* unpack_node(uint64_t word) {
+
+    return (tagged_node*)(word & POINTER_MASK);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the tag held in a packed word
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ * @param[in] word
+ *  Packed pointer and tag
+ *
+ ******************************************************************************/
+static inline uint64_t unpack_tag(uint64_t word) {
+
+    return word >> TAG_SHIFT;
+
+}
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Tagged_T_stack class
+ *
+ * @details
+ *  Starts the stack and its free list empty with a tag of zero
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Tagged_T_stack::Tagged_T_stack() {
+
+    top.store(pack(NULL, 0), RELAXED);
+    free_list.store(pack(NULL, 0), RELAXED);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the Tagged_T_stack class
+ *
+ * @details
+ *  Nodes are only handed back to the allocator here, every node left on the stack or
+ *  the free list is deleted
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+Tagged_T_stack::~Tagged_T_stack() {
+
+    tagged_node* garbage;
+
+    while((garbage = pop_node(top)) != NULL) {
+
+        delete(garbage);
+
+    }
+
+    while((garbage = pop_node(free_list)) != NULL) {
+
+        delete(garbage);
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Pushes a node onto a tagged list head
+ *
+ * @details
+ *  Every successful CAS bumps the tag, so a head that was popped and pushed back in between
+ *  a load and a CAS no longer compares equal
+ *
+ * @note
+ *  none
+ *
+ * @param[in] head
+ *  Top of the stack or of the free list
+ *
+ * @param[in] node
+ *  Node to push
+ *
+ ******************************************************************************/
+void Tagged_T_stack::push_node(atomic<uint64_t>& head, tagged_node* node) {
+
+    uint64_t old_head = head.load(ACQ);
+
+    while(true) {
+
+        node->next.store(unpack_node(old_head), RELAXED);
+
+        if(head.compare_exchange_weak(old_head, pack(node, unpack_tag(old_head) + 1), ACQREL, ACQ)) {
+
+            return;
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Pops a node from a tagged list head
+ *
+ * @details
+ *  The node read as the head may be popped, recycled and pushed again before the CAS. Reading
+ *  its next pointer stays safe because nodes are never freed while the stack is in use, and the
+ *  CAS fails because the tag has moved on even if the same node is back on top.
+ *
+ * @note
+ *  Returns NULL if the list is empty
+ *
+ * @param[in] head
+ *  Top of the stack or of the free list
+ *
+ ******************************************************************************/
+tagged_node* Tagged_T_stack::pop_node(atomic<uint64_t>& head) {
+
+    uint64_t old_head = head.load(ACQ);
+
+    while(true) {
+
+        tagged_node* to_pop = unpack_node(old_head);
+
+        if(to_pop == NULL) {
+
+            return NULL;
+
+        }
+
+        tagged_node* new_top = to_pop->next.load(RELAXED);
+
+        if(head.compare_exchange_weak(old_head, pack(new_top, unpack_tag(old_head) + 1), ACQREL, ACQ)) {
+
+            return to_pop;
+
+        }
+
+    }
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the push method for the Tagged_T_stack class
+ *
+ * @details
+ *  Takes a node from the free list, only allocating when the free list is empty, and pushes
+ *  it on the stack
+ *
+ * @note
+ *  none
+ *
+ * @param[in] val
+ *  Value of the new top node
+ *
+ ******************************************************************************/
+void Tagged_T_stack::push(int val) {
+
+    tagged_node* new_top = pop_node(free_list);
+
+    if(new_top == NULL) {
+
+        new_top = new tagged_node;
+
+    }
+
+    new_top->val = val;
+    push_node(top, new_top);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  This is the pop method for the Tagged_T_stack class
+ *
+ * @details
+ *  Pops the top node and puts it straight back on the free list, no reclamation scheme is needed
+ *
+ * @note
+ *  Function will return -1 if stack is empty
+ *
+ ******************************************************************************/
+int Tagged_T_stack::pop() {
+
+    tagged_node* to_pop = pop_node(top);
+
+    if(to_pop == NULL) {
+
+        return -1;
+
+    }
+
+    int value = to_pop->val;
+    push_node(free_list, to_pop);
+
+    return value;
+
+}
@@ -0,0 +1,61 @@
+/*
+ * Tagged_Treiber_Stack.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef TAGGED_TS_HPP
+#define TAGGED_TS_HPP
+#include <iostream>
+#include <atomic>
+#include <stdint.h>
+
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::atomic;
+
+#define ACQREL std::memory_order_acq_rel
+#define ACQ std::memory_order_acquire
+#define RELAXED std::memory_order_relaxed
+
+// x86-64 and AArch64 user space pointers fit in the low 48 bits, the high 16 bits hold the tag
+#define TAG_SHIFT 48
+#define POINTER_MASK ((1ULL << TAG_SHIFT) - 1)
+
+static_assert(sizeof(void*) == 8, "Tagged pointers need 64 bit pointers");
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// next is atomic because a node can be recycled while a stale pop is still reading it
+struct tagged_node {
+
+    int val;
+    atomic<tagged_node*> next;
+
+};
+
+class Tagged_T_stack{
+
+    private:
+    atomic<uint64_t> top;
+    atomic<uint64_t> free_list;
+    void push_node(atomic<uint64_t>& head, tagged_node* node);
+    tagged_node* pop_node(atomic<uint64_t>& head);
+
+    public:
+    Tagged_T_stack();
+    ~Tagged_T_stack();
+    void push(int val);
+    int pop();
+
+};
+
+#endif
@@ -0,0 +1,448 @@
+/**
+ * @file Thread_Placement.cpp
+ * @author David Wade IV
+ * @date October 19th, 2026
+ * @brief Contains all the functions for placing test threads on CPUs
+ *
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#include "Thread_Placement.hpp"
+
+//***********************************************************************************
+// static functions/variables
+//***********************************************************************************
+
+// Fills both hardware threads of a core before the next core
+static bool smt_first_order(const cpu_location& a, const cpu_location& b) {
+
+    if(a.package != b.package) return a.package < b.package;
+    if(a.core_rank != b.core_rank) return a.core_rank < b.core_rank;
+    return a.sibling < b.sibling;
+
+}
+
+// One thread per core of a socket, then its second hardware threads, then the next socket
+static bool compact_order(const cpu_location& a, const cpu_location& b) {
+
+    if(a.package != b.package) return a.package < b.package;
+    if(a.sibling != b.sibling) return a.sibling < b.sibling;
+    return a.core_rank < b.core_rank;
+
+}
+
+// One thread per socket in turn, one per core, then the second hardware threads
+static bool scatter_order(const cpu_location& a, const cpu_location& b) {
+
+    if(a.sibling != b.sibling) return a.sibling < b.sibling;
+    if(a.core_rank != b.core_rank) return a.core_rank < b.core_rank;
+    return a.package < b.package;
+
+}
+
+//***********************************************************************************
+// functions
+//***********************************************************************************
+
+/***************************************************************************//**
+ * @brief
+ *  This is the constructor for the Thread_Placement class
+ *
+ * @details
+ *  Orders the CPUs the process may run on by the placement policy. An unknown policy, a list
+ *  that does not parse or a list naming a CPU the process may not run on leave the placement invalid,
+ *  as does an empty policy, which means threads are not pinned.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] pin_policy
+ *  compact, scatter, smt-first or list:CPUS
+ *
+ ******************************************************************************/
+Thread_Placement::Thread_Placement(string pin_policy) {
+
+    policy = pin_policy;
+    placement_valid = false;
+
+    if(policy.empty()) {
+
+        return;
+
+    }
+
+    vector<cpu_location> locations = available_cpus();
+
+    if(policy.compare(0, 5, "list:") == 0) {
+
+        if(!parse_cpu_list(policy.substr(5), &cpus)) {
+
+            return;
+
+        }
+
+        for(size_t i = 0; i < cpus.size(); i++) {
+
+            bool allowed = false;
+
+            for(size_t j = 0; j < locations.size(); j++) {
+
+                allowed = allowed || locations[j].cpu == cpus[i];
+
+            }
+
+            if(!allowed) {
+
+                return;
+
+            }
+
+        }
+
+        placement_valid = !cpus.empty();
+
+        return;
+
+    }
+
+    if(policy.compare("compact") == 0) {
+
+        std::stable_sort(locations.begin(), locations.end(), compact_order);
+
+    }
+    else if(policy.compare("smt-first") == 0) {
+
+        std::stable_sort(locations.begin(), locations.end(), smt_first_order);
+
+    }
+    else if(policy.compare("scatter") == 0) {
+
+        std::stable_sort(locations.begin(), locations.end(), scatter_order);
+
+    }
+    else {
+
+        return;
+
+    }
+
+    for(size_t i = 0; i < locations.size(); i++) {
+
+        cpus.push_back(locations[i].cpu);
+
+    }
+
+    placement_valid = !cpus.empty();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Parses a CPU list such as 0,2,4-7
+ *
+ * @details
+ *  Ranges are inclusive and CPUs keep the order they are given in
+ *
+ * @note
+ *  Returns false if the list does not parse
+ *
+ ******************************************************************************/
+bool Thread_Placement::parse_cpu_list(string list, vector<int>* parsed) {
+
+    size_t position = 0;
+
+    while(position < list.size()) {
+
+        size_t end = list.find(',', position);
+        end = end == string::npos ? list.size() : end;
+
+        string entry = list.substr(position, end - position);
+        int first, last;
+        char trailing;
+
+        if(sscanf(entry.c_str(), "%d-%d%c", &first, &last, &trailing) == 2) {}
+        else if(sscanf(entry.c_str(), "%d%c", &first, &trailing) == 1) {
+
+            last = first;
+
+        }
+        else {
+
+            return false;
+
+        }
+
+        if(first < 0 || last < first || last >= CPU_SETSIZE) {
+
+            return false;
+
+        }
+
+        for(int cpu = first; cpu <= last; cpu++) {
+
+            parsed->push_back(cpu);
+
+        }
+
+        position = end + 1;
+
+    }
+
+    return !parsed->empty();
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Reads one number from a CPU's topology directory
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  Returns the fallback if the file can not be read
+ *
+ ******************************************************************************/
+int Thread_Placement::read_topology(int cpu, const char* file, int fallback) {
+
+    char path[128];
+    snprintf(path, sizeof(path), CPU_TOPOLOGY_PATH "cpu%d/topology/%s", cpu, file);
+
+    FILE* topology = fopen(path, "r");
+
+    if(topology == NULL) {
+
+        return fallback;
+
+    }
+
+    int value;
+
+    if(fscanf(topology, "%d", &value) != 1) {
+
+        value = fallback;
+
+    }
+
+    fclose(topology);
+
+    return value;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns every online CPU the process may run on, with its place in the machine
+ *
+ * @details
+ *  A CPU's sibling number counts the lower numbered CPUs on the same core, and its core rank
+ *  counts the distinct cores below it on the same socket, since core ids can have gaps
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+vector<cpu_location> Thread_Placement::available_cpus() {
+
+    vector<cpu_location> locations;
+    vector<int> online;
+    cpu_set_t allowed;
+
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    FILE* online_file = fopen(CPU_TOPOLOGY_PATH "online", "r");
+    char online_list[4096];
+
+    if(online_file == NULL || fgets(online_list, sizeof(online_list), online_file) == NULL ||
+        !parse_cpu_list(string(online_list).substr(0, string(online_list).find('\n')), &online)) {
+
+        online.clear();
+
+        for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+
+            online.push_back(cpu);
+
+        }
+
+    }
+
+    if(online_file != NULL) {
+
+        fclose(online_file);
+
+    }
+
+    for(size_t i = 0; i < online.size(); i++) {
+
+        if(!CPU_ISSET(online[i], &allowed)) {
+
+            continue;
+
+        }
+
+        cpu_location location;
+        location.cpu = online[i];
+        location.package = read_topology(online[i], "physical_package_id", 0);
+        location.core = read_topology(online[i], "core_id", online[i]);
+        location.sibling = 0;
+        location.core_rank = 0;
+
+        for(size_t j = 0; j < locations.size(); j++) {
+
+            if(locations[j].package == location.package && locations[j].core == location.core) {
+
+                location.sibling++;
+
+            }
+
+        }
+
+        locations.push_back(location);
+
+    }
+
+    for(size_t i = 0; i < locations.size(); i++) {
+
+        vector<int> lower_cores;
+
+        for(size_t j = 0; j < locations.size(); j++) {
+
+            if(locations[j].package == locations[i].package && locations[j].core < locations[i].core &&
+                std::find(lower_cores.begin(), lower_cores.end(), locations[j].core) == lower_cores.end()) {
+
+                lower_cores.push_back(locations[j].core);
+
+            }
+
+        }
+
+        locations[i].core_rank = lower_cores.size();
+
+    }
+
+    return locations;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns whether the placement policy could be applied on this machine
+ *
+ * @details
+ *  none
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+bool Thread_Placement::valid() {
+
+    return placement_valid;
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Returns the CPU a thread runs on
+ *
+ * @details
+ *  Threads past the last CPU wrap around to the first
+ *
+ * @note
+ *  Only call on a valid placement
+ *
+ * @param[in] tid
+ *  Test thread
+ *
+ ******************************************************************************/
+int Thread_Placement::cpu(int tid) {
+
+    return cpus[tid % cpus.size()];
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Pins a running thread to its CPU
+ *
+ * @details
+ *  Returns the result of pthread_setaffinity_np
+ *
+ * @note
+ *  none
+ *
+ * @param[in] thread
+ *  Thread to pin
+ *
+ * @param[in] tid
+ *  Test thread id the CPU is chosen by
+ *
+ ******************************************************************************/
+int Thread_Placement::pin(pthread_t thread, int tid) {
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu(tid), &set);
+
+    return pthread_setaffinity_np(thread, sizeof(set), &set);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Pins a thread that is about to be created to its CPU
+ *
+ * @details
+ *  The thread starts on its CPU, so nothing it touches before the start barrier is first
+ *  touched from another CPU. Returns the result of pthread_attr_setaffinity_np.
+ *
+ * @note
+ *  none
+ *
+ * @param[in] attributes
+ *  Attributes the thread will be created with
+ *
+ * @param[in] tid
+ *  Test thread id the CPU is chosen by
+ *
+ ******************************************************************************/
+int Thread_Placement::pin(pthread_attr_t* attributes, int tid) {
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu(tid), &set);
+
+    return pthread_attr_setaffinity_np(attributes, sizeof(set), &set);
+
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Describes where each thread runs, for the results
+ *
+ * @details
+ *  The policy followed by the CPU of every thread in tid order
+ *
+ * @note
+ *  none
+ *
+ * @param[in] number_of_threads
+ *  Threads in the test
+ *
+ ******************************************************************************/
+string Thread_Placement::describe(int number_of_threads) {
+
+    string description = policy + " (cpus";
+
+    for(int i = 0; i < number_of_threads; i++) {
+
+        description += " " + std::to_string(cpu(i));
+
+    }
+
+    return description + ")";
+
+}
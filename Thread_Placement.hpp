@@ -0,0 +1,84 @@
+/*
+ * Thread_Placement.hpp
+ *
+ *  Created on: Oct 19th, 2026
+ *      Author: David Wade IV
+ */
+
+//***********************************************************************************
+// Include files
+//***********************************************************************************
+#ifndef THREAD_PLACEMENT_HPP
+#define THREAD_PLACEMENT_HPP
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+//***********************************************************************************
+// defined files
+//***********************************************************************************
+using std::string;
+using std::vector;
+
+#define CPU_TOPOLOGY_PATH "/sys/devices/system/cpu/"
+
+//***********************************************************************************
+// data structure prototypes
+//***********************************************************************************
+
+// Where one CPU sits in the machine, sibling is its position among the hardware threads of its core
+struct cpu_location {
+
+    int cpu;
+    int package;
+    int core;
+    int core_rank;
+    int sibling;
+
+};
+
+/***************************************************************************//**
+ * @brief
+ *  Decides which CPU each test thread runs on
+ *
+ * @details
+ *  The CPUs the process may run on are read along with their socket and core from the /sys CPU
+ *  topology, then ordered by the placement policy. Thread i runs on the i-th CPU of that order,
+ *  wrapping around when there are more threads than CPUs.
+ *
+ *  compact fills one core of a socket after another with a single thread each, and only uses
+ *  the second hardware thread of a core once every core of the socket is busy, moving on to the
+ *  next socket once the socket is full. smt-first fills both hardware threads of a core before
+ *  moving to the next core. scatter spreads threads round robin over the sockets, one per core,
+ *  before doubling up on any core. list:CPUS takes the CPUs in the given order, e.g.
+ *  list:0,2,4-7.
+ *
+ * @note
+ *  Without the topology files every CPU counts as its own core on socket 0
+ *
+ ******************************************************************************/
+class Thread_Placement {
+
+    private:
+    string policy;
+    vector<int> cpus;
+    bool placement_valid;
+    static bool parse_cpu_list(string list, vector<int>* parsed);
+    static int read_topology(int cpu, const char* file, int fallback);
+    static vector<cpu_location> available_cpus();
+
+    public:
+    Thread_Placement(string pin_policy);
+    bool valid();
+    int cpu(int tid);
+    int pin(pthread_t thread, int tid);
+    int pin(pthread_attr_t* attributes, int tid);
+    string describe(int number_of_threads);
+
+};
+
+#endif
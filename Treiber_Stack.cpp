@@ -20,75 +20,127 @@
  *  This is the constructor for the Treiber_Stack Class
  *
  * @details
- *  Initialize the global lock and set top to a new instance of the tstack_node struct. If elimination optimization is enabled,
- *  also intializes the elimination array and fills it with NULL values. 
+ *  Initialize the node pool and set top to NULL. Only the elimination variant builds an elimination array.
  *
  * @note
  * none
  *
  ******************************************************************************/
-T_stack::T_stack(int number_of_threads, int iterations) {
+template<optimization_variant V>
+T_stack<V>::T_stack(int number_of_threads) : elimination(number_of_threads), pool(number_of_threads) {
 
     tstack_node* n = NULL;
     top.store(n, ACQREL);
+    ibr = NULL;
 
-    #ifdef ELIMINATION_OPTIMIZATION_ON
+}  
 
-    ELIM_ARRAY_SIZE = (number_of_threads * iterations)/2;
-    elimination_array = new atomic<treiber_elimination_operations*>[ELIM_ARRAY_SIZE];
+/***************************************************************************//**
+ * @brief
+ *  This is the destructor for the Treiber_Stack class
+ *
+ * @details
+ *  Nodes left on the stack are freed along with the node pool
+ *
+ * @note
+ *  none
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+T_stack<V>::~T_stack() {
 
-    for(int i = 0; i < ELIM_ARRAY_SIZE; i++) {
+    top.store(NULL, ACQREL);
 
-        elimination_array[i].store(NULL);
+}
 
-    }
+/***************************************************************************//**
+ * @brief
+ *  Has the stack read top through interval based reclamation
+ *
+ * @details
+ *  Once set, pop protects the nodes it reads and new nodes are stamped with their birth era
+ *
+ * @note
+ *  Set before any thread uses the stack
+ *
+ * @param[in] interval_reclamation
+ *  Reclamation instance the popped nodes will be retired to
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+void T_stack<V>::set_ibr(IBR* interval_reclamation) {
 
-    #endif
+    ibr = interval_reclamation;
 
-}  
+}
 
 /***************************************************************************//**
  * @brief
- *  This is the destructor for the Treiber_Stack class
+ *  Returns the pool the stack allocates its nodes from
  *
  * @details
- *  Deletes the elimination array if the optimization is turned on
+ *  Popped nodes are retired with Node_Pool::reclaim and this pool as the context, so they are
+ *  recycled instead of going back to malloc
  *
  * @note
  *  none
  *
  ******************************************************************************/
-T_stack::~T_stack() {
+template<optimization_variant V>
+Node_Pool<tstack_node>* T_stack<V>::node_pool() {
 
-    top.store(NULL, ACQREL);
+    return &pool;
 
-    #ifdef ELIMINATION_OPTIMIZATION_ON
+}
 
-    delete [] elimination_array;
+/***************************************************************************//**
+ * @brief
+ *  Returns the stack's elimination array
+ *
+ * @details
+ *  Used to report how many operations were eliminated
+ *
+ * @note
+ *  NULL unless this is the elimination variant
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+Elimination_Array* T_stack<V>::elimination_array() {
 
-    #endif
+    if constexpr(V == elimination_variant) {
+        return &elimination;
+    }
+
+    return NULL;
 
 }
 
 /***************************************************************************//**
  * @brief
- *  This is a time delay function. 
+ *  Allocates a tstack_node
  *
  * @details
- *  none
+ *  Takes the node from the calling thread's pool magazine and stamps it with its birth era
+ *  when interval based reclamation is in use
  *
  * @note
- * 	none
+ *  none
  *
- * @param[in] milliseconds
- *  Length of delay in milliseconds
+ * @param[in] val
+ *  Value of the new node
+ *
+ * @param[in] tid
+ *  Calling thread
  *
  ******************************************************************************/
-static void time_delay(int milliseconds) {
+template<optimization_variant V>
+tstack_node* T_stack<V>::new_node(int val, int tid) {
 
-    clock_t start_time = clock();
+    tstack_node* n = pool.allocate(tid);
+    n->val = val;
+    n->birth_era = ibr != NULL ? ibr->birth_era(tid) : 0;
 
-    while(clock() < start_time + milliseconds) {};
+    return n;
 
 }
 
@@ -97,28 +149,27 @@ static void time_delay(int milliseconds) {
  *  This is the pop method for the Treiber_Stack class
  *
  * @details
- *  Function pops the top of the stack and returns the value of the popped tstack_node. Elimination optimization relieves 
- *  contention on the global lock. The lock holder performs their operation and returns, non lock holders pick a random index in the elimination array 
- *  and see what's in the index. If the complimentary operation is in the index, then the thread will perform both operations and return. If the index is NULL, 
- *  then the operation will place its operation in the index and wait for some delay. It then checks if its operation was commpleted by another thread. If not,
- *  it then contends on lock again. The process is repeated if the thread doesn't acquire the lock. 
+ *  Function pops the top of the stack and returns the popped tstack_node. Elimination optimization relieves
+ *  contention on top. A pop that loses the CAS on top tries once to take a node straight from a concurrent push
+ *  through the elimination array before trying the stack again.
  *
  * @note
  * 	Function will return NULL if stack is empty
  *
+ * @param[in] tid
+ *  Calling thread
+ *
  ******************************************************************************/
-tstack_node* T_stack::pop() {
+template<optimization_variant V>
+tstack_node* T_stack<V>::pop(int tid) {
 
     while(true){
 
-        tstack_node* to_pop = top.load(ACQ);
+        tstack_node* to_pop = ibr != NULL ? ibr->protect(tid, top) : top.load(ACQ);
 
         if(to_pop == NULL) {
 
-            tstack_node* end_signal = new tstack_node;
-            end_signal->val = -1;
-
-            return end_signal;
+            return NULL;
              
         }
         
@@ -131,66 +182,19 @@ tstack_node* T_stack::pop() {
 
         }
 
-        #ifdef ELIMINATION_OPTIMIZATION_ON
-        // Elimination optimization
-        else {
-
-            while(true) {
-
-                int index = rand() % ELIM_ARRAY_SIZE;
-                treiber_elimination_operations* elimination_index = elimination_array[index].load(ACQ);
+        if constexpr(V == elimination_variant) {
 
-                // Empty slot in elimination array
-                if(elimination_index == NULL) {
+            // The pushed node never reached the stack, so no other thread can hold it
+            tstack_node* eliminated = (tstack_node*)elimination.exchange_pop(tid);
 
-                    treiber_elimination_operations* operation = new treiber_elimination_operations;
-                    operation->pop = true;
-                    operation->push = false;
+            if(eliminated != NULL) {
 
-                    // Place operation into array
-                    if(elimination_array[index].compare_exchange_strong(elimination_index, operation, ACQREL)) {
-
-                        // Figure out how long to delay
-                        time_delay(200);
-                        treiber_elimination_operations* temp = elimination_array[index].load(ACQ);
-
-                        // No one combined while waiting
-                        if(temp != NULL) {
-
-                            // Take operation out and try again on stack
-                            elimination_array[index].compare_exchange_strong(temp, NULL);
-                            tstack_node* return_node = pop();
-                            return return_node;
-
-                        }
-
-                    }
-
-                }
-
-                // Slot has a push operation
-                else if(elimination_index->push) {
-
-                    // Perform matching operations and remove operation from elimination array
-                    if(elimination_array[index].compare_exchange_strong(elimination_index, NULL, ACQREL)) {
-
-                        int value = elimination_index->push_value;
-                        tstack_node* return_node = new tstack_node;
-                        return_node->val = value;
-            
-                        delete(elimination_index);
-                        return return_node;
-
-                    }
-
-                }
+                return eliminated;
 
             }
 
         }
 
-        #endif
-
     }
 
 }
@@ -200,11 +204,9 @@ tstack_node* T_stack::pop() {
  *  This is the push method for the Treiber_Stack class
  *
  * @details
- *  Pushes a new tstack_node to the top of the stack. Elimination optimization relieves contention on the global lock. 
- *  The lock holder performs their operation and returns, non lock holders pick a random index in the elimination array 
- *  and see what's in the index. If the complimentary operation is in the index, then the thread will perform both operations and return. If the index is NULL, 
- *  then the operation will place its operation in the index and wait for some delay. It then checks if its operation was commpleted by another thread. If not,
- *  it then contends on lock again. The process is repeated if the thread doesn't acquire the lock. 
+ *  Pushes a new tstack_node to the top of the stack. Elimination optimization relieves contention on top.
+ *  A push that loses the CAS on top tries once to hand its node straight to a concurrent pop through the
+ *  elimination array before trying the stack again.
  *
  * @note
  * 	none
@@ -212,11 +214,14 @@ tstack_node* T_stack::pop() {
  * @param[in] val
  *  Value of the new top tstack_node
  *
+ * @param[in] tid
+ *  Calling thread
+ *
  ******************************************************************************/
-void T_stack::push(int val) {
+template<optimization_variant V>
+void T_stack<V>::push(int val, int tid) {
 
-    tstack_node* new_top = new tstack_node;
-    new_top->val = val;
+    tstack_node* new_top = new_node(val, tid);
 
     while(true) {
 
@@ -231,63 +236,96 @@ void T_stack::push(int val) {
 
         }
 
-        #ifdef ELIMINATION_OPTIMIZATION_ON
-        else {
+        if constexpr(V == elimination_variant) {
 
-            while(true) {
+            if(elimination.exchange_push(tid, new_top)) {
 
-                int index = rand() % ELIM_ARRAY_SIZE;
-                treiber_elimination_operations* elimination_index = elimination_array[index].load(ACQ);
+                return;
 
-                // Empty slot in elimination array
-                if(elimination_index == NULL) {
+            }
 
-                    treiber_elimination_operations* operation = new treiber_elimination_operations;
-                    operation->pop = false;
-                    operation->push = true;
-                    operation->push_value = val;
+        }
 
-                    // Place operation into array
-                    if(elimination_array[index].compare_exchange_strong(elimination_index, operation, ACQREL)) {
+    }
 
-                        // Figure out how long to delay
-                        time_delay(200);
-                        treiber_elimination_operations* temp = elimination_array[index].load(ACQ);
+}
 
-                        // No one combined while waiting
-                        if(temp != NULL) {
+/***************************************************************************//**
+ * @brief
+ *  Pushes a batch of values with a single CAS on top
+ *
+ * @details
+ *  The batch is linked into a private chain first, so no other thread can see it until the CAS
+ *  splices the whole chain onto top. Only the link from the bottom of the chain to the old top is
+ *  rewritten when the CAS is retried. The values end up in the same order as pushing them one at
+ *  a time, vals[count - 1] becomes the new top.
+ *
+ * @note
+ * 	Bulk pushes do not use the elimination array
+ *
+ * @param[in] vals
+ *  Values to push
+ *
+ * @param[in] count
+ *  Number of values
+ *
+ * @param[in] tid
+ *  Calling thread
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+void T_stack<V>::push_bulk(int* vals, int count, int tid) {
+
+    if(count <= 0) {
 
-                            // Take operation out and try again on stack
-                            elimination_array[index].compare_exchange_strong(temp, NULL);
-                            push(val);
-                            return;
+        return;
 
-                        }
+    }
 
-                    }
+    tstack_node* bottom = new_node(vals[0], tid);
+    tstack_node* new_top = bottom;
 
-                }
+    for(int i = 1; i < count; i++) {
 
-                // Slot has a push operation
-                else if(elimination_index->pop) {
+        tstack_node* n = new_node(vals[i], tid);
+        n->next = new_top;
+        new_top = n;
 
-                    // Perform matching operations and remove operation from elimination array
-                    if(elimination_array[index].compare_exchange_strong(elimination_index, NULL, ACQREL)) {
-            
-                        delete(new_top);
-                        delete(elimination_index);
-                        return;
+    }
 
-                    }
+    tstack_node* old_top = top.load(ACQ);
 
-                }
+    do {
 
-            }
+        bottom->next = old_top;
 
-        }
+    } while(!top.compare_exchange_weak(old_top, new_top, ACQREL, ACQ));
 
-        #endif
+}
 
-    }
+/***************************************************************************//**
+ * @brief
+ *  Empties the stack with a single exchange on top
+ *
+ * @details
+ *  Returns the whole stack as a chain linked through next, top first. The exchange never reads a
+ *  node, so it needs no protection from the reclamation scheme.
+ *
+ * @note
+ * 	Function will return NULL if stack is empty. Other threads may still be reading the returned
+ *  nodes, so each one must be retired like a popped node.
+ *
+ * @param[in] tid
+ *  Calling thread, unused since nothing is protected
+ *
+ ******************************************************************************/
+template<optimization_variant V>
+tstack_node* T_stack<V>::pop_all(int) {
+
+    return top.exchange(NULL, ACQREL);
+
+}
 
-}
\ No newline at end of file
+// Variants of the Treiber stack
+template class T_stack<base_variant>;
+template class T_stack<elimination_variant>;
@@ -12,6 +12,11 @@
 #define TS_HPP
 #include <iostream>
 #include <atomic>
+#include <stdint.h>
+#include "IBR.hpp"
+#include "Node_Pool.hpp"
+#include "Elimination_Array.hpp"
+#include "Optimization_Variant.hpp"
 
 
 //***********************************************************************************
@@ -22,8 +27,6 @@ using std::atomic;
 #define ACQREL std::memory_order_acq_rel
 #define ACQ std::memory_order_acquire
 
-#define ELIMINATION_OPTIMIZATION_ON
-
 
 //***********************************************************************************
 // data structure prototypes
@@ -33,29 +36,33 @@ struct tstack_node {
 
     int val;
     tstack_node* next;
+    uint64_t birth_era;
 
 };
 
-struct treiber_elimination_operations {
-
-    bool pop;
-    bool push;
-    int push_value;
-
-};
-
+// Built as base_variant and elimination_variant
+template<optimization_variant V>
 class T_stack{
 
+    static_assert(V == base_variant || V == elimination_variant, "The Treiber stack only has base and elimination variants");
+
     private:    
     atomic<tstack_node*> top;
-    atomic<treiber_elimination_operations*>* elimination_array;
-    int ELIM_ARRAY_SIZE;
+    variant_state<V == elimination_variant, Elimination_Array> elimination;
+    IBR* ibr;
+    Node_Pool<tstack_node> pool;
+    tstack_node* new_node(int val, int tid);
 
     public:
-    T_stack(int number_of_threads, int iterations);
+    T_stack(int number_of_threads);
     ~T_stack();
-    void push(int val);
-    tstack_node* pop();
+    void set_ibr(IBR* interval_reclamation);
+    Node_Pool<tstack_node>* node_pool();
+    Elimination_Array* elimination_array();
+    void push(int val, int tid);
+    tstack_node* pop(int tid);
+    void push_bulk(int* vals, int count, int tid);
+    tstack_node* pop_all(int tid);
 
 };
 